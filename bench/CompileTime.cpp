@@ -0,0 +1,72 @@
+// Compile time benchmark: serializes TYPE_COUNT registered types, each of
+// them through operator<< and operator>>, so that every type id lookup is
+// instantiated. The build records the time spent (see Tupfile).
+
+#include <serialization/Serial.hpp>
+#include <serialization/TypeList.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#ifndef SERIALIZATION_BENCH_TYPE_COUNT
+#define SERIALIZATION_BENCH_TYPE_COUNT 200
+#endif
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+constexpr std::size_t TYPE_COUNT = SERIALIZATION_BENCH_TYPE_COUNT;
+
+template <std::size_t Index>
+struct Registered {
+    std::int32_t id = 0;
+    std::string name;
+
+    template <typename Serial>
+    void serialize(Serial& serial) const {
+        serial << id << name;
+    }
+
+    template <typename Serial>
+    void deserialize(Serial& serial) {
+        serial >> id >> name;
+    }
+};
+
+template <typename Indices>
+struct MakeRegistry;
+
+template <std::size_t... Indices>
+struct MakeRegistry<std::index_sequence<Indices...>> {
+    using type = serialization::TypeList<Registered<Indices>...>;
+};
+
+using Registry =
+        MakeRegistry<std::make_index_sequence<TYPE_COUNT>>::type;
+using Serial = serialization::Serial<Registry>;
+
+template <typename T>
+void read(Serial& serial) {
+    T value;
+    serial >> value;
+}
+
+template <std::size_t... Indices>
+std::size_t roundTrip(std::index_sequence<Indices...>) {
+    Serial serial;
+    using Expander = int[];
+    (void)Expander{(serial << Registered<Indices>{}, 0)...};
+    (void)Expander{(read<Registered<Indices>>(serial), 0)...};
+    return serial.size();
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
+
+int main() {
+    return roundTrip(std::make_index_sequence<TYPE_COUNT>{}) == 0;
+}
@@ -0,0 +1,887 @@
+#ifndef SERIALIZATION_ADAPTIVERADIXTREE_HPP
+#define SERIALIZATION_ADAPTIVERADIXTREE_HPP
+
+#include "SerialView.hpp"
+#include "detail/ByteSequence.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+namespace art {
+//----------------------------------------------------------------------------//
+
+enum class EntryType : std::uint8_t {
+    leaf,
+    node4,
+    node16,
+    node48,
+    node256
+};
+
+struct Entry {
+    explicit Entry(EntryType type) : type(type) {
+    }
+
+    EntryType type;
+};
+
+//----------------------------------------------------------------------------//
+
+// The bytes of the key follow the leaf in the same allocation.
+template <typename Value>
+struct Leaf : Entry {
+    static Leaf* create(const SerialView& key, Value&& value) {
+        BOOST_ASSERT_MSG(key.size() <= UINT32_MAX, "Key is too long.");
+        void* memory = allocate(sizeof(Leaf) + key.size());
+        Leaf* leaf = nullptr;
+        try {
+            leaf = new (memory) Leaf{static_cast<std::uint32_t>(key.size()),
+                    std::move(value)};
+        } catch (...) {
+            deallocate(memory);
+            throw;
+        }
+        if (key.size() != 0) {
+            std::memcpy(reinterpret_cast<byte*>(leaf) + sizeof(Leaf),
+                    key.data(), key.size());
+        }
+        return leaf;
+    }
+
+    static void destroy(Leaf* leaf) {
+        leaf->~Leaf();
+        deallocate(leaf);
+    }
+
+    const byte* keyData() const {
+        return reinterpret_cast<const byte*>(this) + sizeof(Leaf);
+    }
+
+    SerialView getKey() const {
+        return SerialView{keyData(), keySize};
+    }
+
+    std::uint32_t keySize;
+    Value value;
+
+private:
+#ifdef __cpp_aligned_new
+    constexpr static bool OVER_ALIGNED =
+            alignof(Leaf) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+#else
+    static_assert(alignof(Leaf) <= alignof(std::max_align_t),
+            "Over-aligned values need aligned new (C++17)!");
+    constexpr static bool OVER_ALIGNED = false;
+#endif
+
+    static void* allocate(std::size_t size) {
+#ifdef __cpp_aligned_new
+        if (OVER_ALIGNED) {
+            return ::operator new(size, std::align_val_t{alignof(Leaf)});
+        }
+#endif
+        return ::operator new(size);
+    }
+
+    static void deallocate(void* memory) {
+#ifdef __cpp_aligned_new
+        if (OVER_ALIGNED) {
+            ::operator delete(memory, std::align_val_t{alignof(Leaf)});
+            return;
+        }
+#endif
+        ::operator delete(memory);
+    }
+
+    Leaf(std::uint32_t keySize, Value&& value)
+            : Entry(EntryType::leaf), keySize(keySize),
+              value(std::move(value)) {
+    }
+};
+
+//----------------------------------------------------------------------------//
+
+// Every node has a compressed path (prefix) which is shared by all the keys
+// below it. Only its first MAX_PREFIX_SIZE bytes are kept in the node:
+// lookups skip the rest and compare the whole key at the leaf, updates read
+// it from any leaf below. A key which ends right after the prefix is stored
+// as terminal, the others are stored as children by their next byte.
+struct Node : Entry {
+    constexpr static std::size_t MAX_PREFIX_SIZE = 8;
+
+    explicit Node(EntryType type) : Entry(type) {
+    }
+
+    std::uint16_t childCount = 0;
+    std::uint32_t prefixSize = 0;
+    byte prefix[MAX_PREFIX_SIZE] = {};
+    Entry* terminal = nullptr; // always a leaf
+
+    std::size_t getStoredPrefixSize() const {
+        return std::min<std::size_t>(prefixSize, MAX_PREFIX_SIZE);
+    }
+
+    // Keeps the first bytes of the prefix, which are not moved from.
+    void setPrefix(const byte* data, std::size_t size) {
+        BOOST_ASSERT_MSG(size <= UINT32_MAX, "Prefix is too long.");
+        prefixSize = static_cast<std::uint32_t>(size);
+        if (size != 0) { // data may be null
+            std::memmove(prefix, data, getStoredPrefixSize());
+        }
+    }
+};
+
+// Keys are kept sorted in Node4 and Node16.
+struct Node4 : Node {
+    constexpr static std::size_t CAPACITY = 4;
+
+    Node4() : Node(EntryType::node4) {
+    }
+
+    byte keys[CAPACITY] = {};
+    Entry* children[CAPACITY] = {};
+};
+
+struct Node16 : Node {
+    constexpr static std::size_t CAPACITY = 16;
+
+    Node16() : Node(EntryType::node16) {
+    }
+
+    byte keys[CAPACITY] = {};
+    Entry* children[CAPACITY] = {};
+};
+
+// childIndex is 1 + the slot of the child, or 0 if there is no child.
+struct Node48 : Node {
+    constexpr static std::size_t CAPACITY = 48;
+
+    Node48() : Node(EntryType::node48) {
+    }
+
+    byte childIndex[256] = {};
+    Entry* children[CAPACITY] = {};
+};
+
+struct Node256 : Node {
+    constexpr static std::size_t CAPACITY = 256;
+
+    Node256() : Node(EntryType::node256) {
+    }
+
+    Entry* children[CAPACITY] = {};
+};
+
+//----------------------------------------------------------------------------//
+
+inline Entry** findChild(Node* node, byte key) {
+    switch (node->type) {
+    case EntryType::node4: {
+        Node4* node4 = static_cast<Node4*>(node);
+        for (std::size_t i = 0; i < node4->childCount; ++i) {
+            if (node4->keys[i] == key) {
+                return &node4->children[i];
+            }
+        }
+        return nullptr;
+    }
+    case EntryType::node16: {
+        Node16* node16 = static_cast<Node16*>(node);
+#ifdef __SSE2__
+        const __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(
+                static_cast<char>(key)), _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(node16->keys)));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                matches)) & ((1U << node16->childCount) - 1);
+        return mask == 0 ? nullptr :
+                &node16->children[__builtin_ctz(mask)];
+#else
+        for (std::size_t i = 0; i < node16->childCount; ++i) {
+            if (node16->keys[i] == key) {
+                return &node16->children[i];
+            }
+        }
+        return nullptr;
+#endif
+    }
+    case EntryType::node48: {
+        Node48* node48 = static_cast<Node48*>(node);
+        const byte index = node48->childIndex[key];
+        return index == 0 ? nullptr : &node48->children[index - 1];
+    }
+    case EntryType::node256: {
+        Node256* node256 = static_cast<Node256*>(node);
+        return node256->children[key] == nullptr ? nullptr :
+                &node256->children[key];
+    }
+    case EntryType::leaf:
+        break;
+    }
+    return nullptr;
+}
+
+// Calls visitor(key, child) in the order of the keys.
+template <typename Visitor>
+void forEachChild(const Node* node, Visitor&& visitor) {
+    switch (node->type) {
+    case EntryType::node4: {
+        const Node4* node4 = static_cast<const Node4*>(node);
+        for (std::size_t i = 0; i < node4->childCount; ++i) {
+            visitor(node4->keys[i], node4->children[i]);
+        }
+        break;
+    }
+    case EntryType::node16: {
+        const Node16* node16 = static_cast<const Node16*>(node);
+        for (std::size_t i = 0; i < node16->childCount; ++i) {
+            visitor(node16->keys[i], node16->children[i]);
+        }
+        break;
+    }
+    case EntryType::node48: {
+        const Node48* node48 = static_cast<const Node48*>(node);
+        for (std::size_t key = 0; key < 256; ++key) {
+            if (node48->childIndex[key] != 0) {
+                visitor(static_cast<byte>(key),
+                        node48->children[node48->childIndex[key] - 1]);
+            }
+        }
+        break;
+    }
+    case EntryType::node256: {
+        const Node256* node256 = static_cast<const Node256*>(node);
+        for (std::size_t key = 0; key < 256; ++key) {
+            if (node256->children[key] != nullptr) {
+                visitor(static_cast<byte>(key), node256->children[key]);
+            }
+        }
+        break;
+    }
+    case EntryType::leaf:
+        break;
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+template <typename Target>
+Target* moveHeader(Node* source, Target* target) {
+    target->childCount = source->childCount;
+    target->setPrefix(source->prefix, source->prefixSize);
+    target->terminal = source->terminal;
+    return target;
+}
+
+template <typename SortedNode>
+void insertSorted(SortedNode* node, byte key, Entry* child) {
+    std::size_t position = 0;
+    while (position < node->childCount && node->keys[position] < key) {
+        ++position;
+    }
+    std::size_t count = node->childCount - position;
+    std::memmove(node->keys + position + 1, node->keys + position, count);
+    std::memmove(node->children + position + 1, node->children + position,
+            count * sizeof(Entry*));
+    node->keys[position] = key;
+    node->children[position] = child;
+    ++node->childCount;
+}
+
+template <typename SortedNode>
+void removeSorted(SortedNode* node, byte key) {
+    std::size_t position = 0;
+    while (node->keys[position] != key) {
+        ++position;
+    }
+    std::size_t count = node->childCount - position - 1;
+    std::memmove(node->keys + position, node->keys + position + 1, count);
+    std::memmove(node->children + position, node->children + position + 1,
+            count * sizeof(Entry*));
+    --node->childCount;
+}
+
+// Grows the node if it is full. nodeReference is updated if the node is
+// replaced.
+inline void addChild(Entry*& nodeReference, byte key, Entry* child) {
+    Node* node = static_cast<Node*>(nodeReference);
+    switch (node->type) {
+    case EntryType::node4: {
+        Node4* node4 = static_cast<Node4*>(node);
+        if (node4->childCount < Node4::CAPACITY) {
+            insertSorted(node4, key, child);
+            return;
+        }
+        Node16* node16 = moveHeader(node4, new Node16);
+        std::copy(node4->keys, node4->keys + Node4::CAPACITY, node16->keys);
+        std::copy(node4->children, node4->children + Node4::CAPACITY,
+                node16->children);
+        delete node4;
+        nodeReference = node16;
+        insertSorted(node16, key, child);
+        return;
+    }
+    case EntryType::node16: {
+        Node16* node16 = static_cast<Node16*>(node);
+        if (node16->childCount < Node16::CAPACITY) {
+            insertSorted(node16, key, child);
+            return;
+        }
+        Node48* node48 = moveHeader(node16, new Node48);
+        for (std::size_t i = 0; i < Node16::CAPACITY; ++i) {
+            node48->childIndex[node16->keys[i]] = static_cast<byte>(i + 1);
+            node48->children[i] = node16->children[i];
+        }
+        delete node16;
+        nodeReference = node48;
+        addChild(nodeReference, key, child);
+        return;
+    }
+    case EntryType::node48: {
+        Node48* node48 = static_cast<Node48*>(node);
+        if (node48->childCount < Node48::CAPACITY) {
+            std::size_t slot = 0;
+            while (node48->children[slot] != nullptr) {
+                ++slot;
+            }
+            node48->children[slot] = child;
+            node48->childIndex[key] = static_cast<byte>(slot + 1);
+            ++node48->childCount;
+            return;
+        }
+        Node256* node256 = moveHeader(node48, new Node256);
+        for (std::size_t i = 0; i < 256; ++i) {
+            if (node48->childIndex[i] != 0) {
+                node256->children[i] =
+                        node48->children[node48->childIndex[i] - 1];
+            }
+        }
+        delete node48;
+        nodeReference = node256;
+        addChild(nodeReference, key, child);
+        return;
+    }
+    case EntryType::node256: {
+        Node256* node256 = static_cast<Node256*>(node);
+        node256->children[key] = child;
+        ++node256->childCount;
+        return;
+    }
+    case EntryType::leaf:
+        break;
+    }
+}
+
+// Shrinks the node if it became too sparse. nodeReference is updated if the
+// node is replaced.
+inline void removeChild(Entry*& nodeReference, byte key) {
+    Node* node = static_cast<Node*>(nodeReference);
+    switch (node->type) {
+    case EntryType::node4:
+        removeSorted(static_cast<Node4*>(node), key);
+        return;
+    case EntryType::node16: {
+        Node16* node16 = static_cast<Node16*>(node);
+        removeSorted(node16, key);
+        if (node16->childCount > Node4::CAPACITY - 1) {
+            return;
+        }
+        Node4* node4 = moveHeader(node16, new Node4);
+        std::copy(node16->keys, node16->keys + node4->childCount, node4->keys);
+        std::copy(node16->children, node16->children + node4->childCount,
+                node4->children);
+        delete node16;
+        nodeReference = node4;
+        return;
+    }
+    case EntryType::node48: {
+        Node48* node48 = static_cast<Node48*>(node);
+        node48->children[node48->childIndex[key] - 1] = nullptr;
+        node48->childIndex[key] = 0;
+        --node48->childCount;
+        if (node48->childCount > Node16::CAPACITY - 4) {
+            return;
+        }
+        Node16* node16 = moveHeader(node48, new Node16);
+        std::size_t position = 0;
+        for (std::size_t i = 0; i < 256; ++i) {
+            if (node48->childIndex[i] != 0) {
+                node16->keys[position] = static_cast<byte>(i);
+                node16->children[position++] =
+                        node48->children[node48->childIndex[i] - 1];
+            }
+        }
+        delete node48;
+        nodeReference = node16;
+        return;
+    }
+    case EntryType::node256: {
+        Node256* node256 = static_cast<Node256*>(node);
+        node256->children[key] = nullptr;
+        --node256->childCount;
+        if (node256->childCount > Node48::CAPACITY - 12) {
+            return;
+        }
+        Node48* node48 = moveHeader(node256, new Node48);
+        std::size_t slot = 0;
+        for (std::size_t i = 0; i < 256; ++i) {
+            if (node256->children[i] != nullptr) {
+                node48->children[slot] = node256->children[i];
+                node48->childIndex[i] = static_cast<byte>(++slot);
+            }
+        }
+        delete node256;
+        nodeReference = node48;
+        return;
+    }
+    case EntryType::leaf:
+        break;
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+// Filters of the ordered traversal. mayContain() is called with the common
+// prefix of the keys of a subtree, matches() with the keys themselves.
+struct AllKeys {
+    bool mayContain(const ByteSequence&) const {
+        return true;
+    }
+
+    bool matches(const SerialView&) const {
+        return true;
+    }
+};
+
+struct KeysWithPrefix {
+    bool mayContain(const ByteSequence& path) const {
+        const std::size_t size = std::min(path.size(), prefix.size());
+        return size == 0 || std::memcmp(path.data(), prefix.data(), size) == 0;
+    }
+
+    bool matches(const SerialView& key) const {
+        return key.size() >= prefix.size() && (prefix.size() == 0 ||
+                std::memcmp(key.data(), prefix.data(), prefix.size()) == 0);
+    }
+
+    SerialView prefix;
+};
+
+// [low, high)
+struct KeysInRange {
+    bool mayContain(const ByteSequence& path) const {
+        const std::size_t size = std::min(path.size(), low.size());
+        return (size == 0 ||
+                       std::memcmp(path.data(), low.data(), size) >= 0) &&
+                compareBytes(path.data(), path.size(), high.data(),
+                        high.size()) < 0;
+    }
+
+    bool matches(const SerialView& key) const {
+        return !(key < low) && key < high;
+    }
+
+    SerialView low;
+    SerialView high;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace art
+} // namespace detail
+//============================================================================//
+
+// Adaptive radix tree (Leis et al.) keyed by the bytes of Serials, which are
+// binary comparable. Inner nodes grow and shrink between 4, 16, 48 and 256
+// children, paths of single children are compressed into the nodes and a
+// subtree of a single key is just a leaf. Keys may be prefixes of each
+// other. Iteration and scans visit the keys in the order of the Serials.
+template <typename Value>
+class AdaptiveRadixTree {
+private:
+    using Entry = detail::art::Entry;
+    using EntryType = detail::art::EntryType;
+    using Leaf = detail::art::Leaf<Value>;
+    using Node = detail::art::Node;
+
+public:
+    AdaptiveRadixTree() = default;
+
+    AdaptiveRadixTree(const AdaptiveRadixTree&) = delete;
+    AdaptiveRadixTree& operator=(const AdaptiveRadixTree&) = delete;
+
+    AdaptiveRadixTree(AdaptiveRadixTree&& other)
+            : root(other.root), count(other.count) {
+        other.root = nullptr;
+        other.count = 0;
+    }
+
+    AdaptiveRadixTree& operator=(AdaptiveRadixTree&& other) {
+        std::swap(root, other.root);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    ~AdaptiveRadixTree() {
+        destroy(root);
+    }
+
+    // Returns false if the key was already there, its value is replaced.
+    bool insert(const SerialView& key, Value value) {
+        const bool inserted = insert(root, key, 0, std::move(value));
+        count += inserted;
+        return inserted;
+    }
+
+    Value* find(const SerialView& key) {
+        Leaf* leaf = findLeaf(key);
+        return leaf == nullptr ? nullptr : &leaf->value;
+    }
+
+    const Value* find(const SerialView& key) const {
+        const Leaf* leaf = findLeaf(key);
+        return leaf == nullptr ? nullptr : &leaf->value;
+    }
+
+    bool erase(const SerialView& key) {
+        const bool erased = erase(root, key, 0);
+        count -= erased;
+        return erased;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    // visitor(SerialView key, const Value& value) is called for every key in
+    // order.
+    template <typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        detail::ByteSequence path;
+        visit(root, path, detail::art::AllKeys{}, visitor);
+    }
+
+    template <typename Visitor>
+    void scanPrefix(const SerialView& prefix, Visitor&& visitor) const {
+        detail::ByteSequence path;
+        visit(root, path, detail::art::KeysWithPrefix{prefix}, visitor);
+    }
+
+    // Keys in [low, high).
+    template <typename Visitor>
+    void scanRange(const SerialView& low, const SerialView& high,
+            Visitor&& visitor) const {
+        detail::ByteSequence path;
+        visit(root, path, detail::art::KeysInRange{low, high}, visitor);
+    }
+
+private:
+    static bool isLeaf(const Entry* entry) {
+        return entry->type == EntryType::leaf;
+    }
+
+    static bool hasKey(const Leaf* leaf, const SerialView& key) {
+        return leaf->getKey() == key;
+    }
+
+    // Every key below an entry shares the bytes of the path to it.
+    static const Leaf* getAnyLeaf(const Entry* entry) {
+        while (!isLeaf(entry)) {
+            const Node* node = static_cast<const Node*>(entry);
+            if (node->terminal != nullptr) {
+                entry = node->terminal;
+            } else {
+                detail::art::forEachChild(node,
+                        [&entry](detail::byte, const Entry* child) {
+                            entry = child;
+                        });
+            }
+        }
+        return static_cast<const Leaf*>(entry);
+    }
+
+    // The whole prefix of a node at the depth before its prefix.
+    static const detail::byte* getPrefix(const Node* node, std::size_t depth) {
+        return node->prefixSize <= Node::MAX_PREFIX_SIZE ? node->prefix :
+                getAnyLeaf(node)->keyData() + depth;
+    }
+
+    // Optimistic: only the stored bytes of the prefixes are compared on the
+    // way, the key of the leaf is compared at the end.
+    Leaf* findLeaf(const SerialView& key) const {
+        const detail::byte* data = key.data();
+        const std::size_t size = key.size();
+        Entry* entry = root;
+        std::size_t depth = 0;
+        while (entry != nullptr) {
+            if (isLeaf(entry)) {
+                Leaf* leaf = static_cast<Leaf*>(entry);
+                return hasKey(leaf, key) ? leaf : nullptr;
+            }
+            Node* node = static_cast<Node*>(entry);
+            const std::size_t storedSize = node->getStoredPrefixSize();
+            if (node->prefixSize > size - depth || (storedSize != 0 &&
+                    std::memcmp(node->prefix, data + depth,
+                            storedSize) != 0)) {
+                return nullptr;
+            }
+            depth += node->prefixSize;
+            if (depth == size) {
+                entry = node->terminal;
+                continue;
+            }
+            Entry** child = detail::art::findChild(node, data[depth]);
+            entry = child == nullptr ? nullptr : *child;
+            ++depth;
+        }
+        return nullptr;
+    }
+
+    // Adds a new leaf into a node at the depth after its prefix.
+    static void addLeaf(Entry*& nodeReference, Leaf* leaf, std::size_t depth) {
+        Node* node = static_cast<Node*>(nodeReference);
+        if (leaf->keySize == depth) {
+            node->terminal = leaf;
+        } else {
+            detail::art::addChild(nodeReference, leaf->keyData()[depth], leaf);
+        }
+    }
+
+    bool insert(Entry*& entry, const SerialView& key, std::size_t depth,
+            Value&& value) {
+        if (entry == nullptr) {
+            entry = Leaf::create(key, std::move(value));
+            return true;
+        }
+
+        if (isLeaf(entry)) {
+            Leaf* leaf = static_cast<Leaf*>(entry);
+            if (hasKey(leaf, key)) {
+                leaf->value = std::move(value);
+                return false;
+            }
+            // Both keys share the bytes up to depth.
+            const std::size_t commonSize = detail::getCommonPrefixSize(
+                    leaf->keyData() + depth, leaf->keySize - depth,
+                    key.data() + depth, key.size() - depth);
+            Node* node = new detail::art::Node4;
+            node->setPrefix(key.data() + depth, commonSize);
+            entry = node;
+            addLeaf(entry, leaf, depth + commonSize);
+            addLeaf(entry, Leaf::create(key, std::move(value)),
+                    depth + commonSize);
+            return true;
+        }
+
+        Node* node = static_cast<Node*>(entry);
+        const std::size_t prefixSize = node->prefixSize;
+        const detail::byte* prefix = getPrefix(node, depth);
+        const std::size_t matchingSize = detail::getCommonPrefixSize(
+                prefix, prefixSize, key.data() + depth, key.size() - depth);
+        if (matchingSize < prefixSize) {
+            // Split the prefix: the node goes under a new one.
+            Node* parent = new detail::art::Node4;
+            parent->setPrefix(prefix, matchingSize);
+            const detail::byte nodeKey = prefix[matchingSize];
+            node->setPrefix(prefix + matchingSize + 1,
+                    prefixSize - matchingSize - 1);
+            entry = parent;
+            detail::art::addChild(entry, nodeKey, node);
+            addLeaf(entry, Leaf::create(key, std::move(value)),
+                    depth + matchingSize);
+            return true;
+        }
+
+        depth += prefixSize;
+        if (depth == key.size()) {
+            if (node->terminal != nullptr) {
+                static_cast<Leaf*>(node->terminal)->value = std::move(value);
+                return false;
+            }
+            node->terminal = Leaf::create(key, std::move(value));
+            return true;
+        }
+        Entry** child = detail::art::findChild(node, key.data()[depth]);
+        if (child != nullptr) {
+            return insert(*child, key, depth + 1, std::move(value));
+        }
+        detail::art::addChild(entry, key.data()[depth],
+                Leaf::create(key, std::move(value)));
+        return true;
+    }
+
+    bool erase(Entry*& entry, const SerialView& key, std::size_t depth) {
+        if (entry == nullptr) {
+            return false;
+        }
+        if (isLeaf(entry)) {
+            if (!hasKey(static_cast<Leaf*>(entry), key)) {
+                return false;
+            }
+            Leaf::destroy(static_cast<Leaf*>(entry));
+            entry = nullptr;
+            return true;
+        }
+
+        // Optimistic like findLeaf(), the leaf is compared at the end.
+        Node* node = static_cast<Node*>(entry);
+        const std::size_t storedSize = node->getStoredPrefixSize();
+        if (node->prefixSize > key.size() - depth || (storedSize != 0 &&
+                std::memcmp(node->prefix, key.data() + depth,
+                        storedSize) != 0)) {
+            return false;
+        }
+        depth += node->prefixSize;
+        if (depth == key.size()) {
+            if (node->terminal == nullptr ||
+                    !hasKey(static_cast<Leaf*>(node->terminal), key)) {
+                return false;
+            }
+            Leaf::destroy(static_cast<Leaf*>(node->terminal));
+            node->terminal = nullptr;
+            compact(entry);
+            return true;
+        }
+        const detail::byte childKey = key.data()[depth];
+        Entry** child = detail::art::findChild(node, childKey);
+        if (child == nullptr || !erase(*child, key, depth + 1)) {
+            return false;
+        }
+        if (*child == nullptr) {
+            detail::art::removeChild(entry, childKey);
+        }
+        compact(entry);
+        return true;
+    }
+
+    // Removes a node which has a single key or subtree below it.
+    static void compact(Entry*& entry) {
+        Node* node = static_cast<Node*>(entry);
+        if (node->childCount == 0) {
+            entry = node->terminal;
+            destroyNode(node);
+            return;
+        }
+        if (node->childCount > 1 || node->terminal != nullptr) {
+            return;
+        }
+        detail::byte childKey = 0;
+        Entry* child = nullptr;
+        detail::art::forEachChild(node,
+                [&](detail::byte key, Entry* onlyChild) {
+                    childKey = key;
+                    child = onlyChild;
+                });
+        if (!isLeaf(child)) {
+            // The stored bytes of both prefixes are enough for the stored
+            // bytes of the merged one.
+            Node* childNode = static_cast<Node*>(child);
+            detail::byte merged[Node::MAX_PREFIX_SIZE];
+            std::size_t size = node->getStoredPrefixSize();
+            std::memcpy(merged, node->prefix, size);
+            if (size < Node::MAX_PREFIX_SIZE) {
+                merged[size++] = childKey;
+            }
+            const std::size_t childSize = std::min(
+                    childNode->getStoredPrefixSize(),
+                    Node::MAX_PREFIX_SIZE - size);
+            std::memcpy(merged + size, childNode->prefix, childSize);
+            childNode->setPrefix(merged, std::size_t{node->prefixSize} + 1 +
+                    childNode->prefixSize);
+        }
+        entry = child;
+        destroyNode(node);
+    }
+
+    template <typename Filter, typename Visitor>
+    static void visit(const Entry* entry, detail::ByteSequence& path,
+            const Filter& filter, Visitor& visitor) {
+        if (entry == nullptr) {
+            return;
+        }
+        if (isLeaf(entry)) {
+            const Leaf* leaf = static_cast<const Leaf*>(entry);
+            if (filter.matches(leaf->getKey())) {
+                visitor(leaf->getKey(),
+                        static_cast<const Value&>(leaf->value));
+            }
+            return;
+        }
+        const Node* node = static_cast<const Node*>(entry);
+        const std::size_t depth = path.size();
+        const detail::byte* prefix = getPrefix(node, depth);
+        path.insert(path.end(), prefix, prefix + node->prefixSize);
+        if (filter.mayContain(path)) {
+            visit(node->terminal, path, filter, visitor);
+            detail::art::forEachChild(node,
+                    [&](detail::byte key, const Entry* child) {
+                        path.push_back(key);
+                        if (filter.mayContain(path)) {
+                            visit(child, path, filter, visitor);
+                        }
+                        path.pop_back();
+                    });
+        }
+        path.resize(depth);
+    }
+
+    static void destroyNode(Node* node) {
+        switch (node->type) {
+        case EntryType::node4:
+            delete static_cast<detail::art::Node4*>(node);
+            break;
+        case EntryType::node16:
+            delete static_cast<detail::art::Node16*>(node);
+            break;
+        case EntryType::node48:
+            delete static_cast<detail::art::Node48*>(node);
+            break;
+        case EntryType::node256:
+            delete static_cast<detail::art::Node256*>(node);
+            break;
+        case EntryType::leaf:
+            BOOST_ASSERT_MSG(false, "Not a node.");
+            break;
+        }
+    }
+
+    static void destroy(Entry* entry) {
+        if (entry == nullptr) {
+            return;
+        }
+        if (isLeaf(entry)) {
+            Leaf::destroy(static_cast<Leaf*>(entry));
+            return;
+        }
+        Node* node = static_cast<Node*>(entry);
+        destroy(node->terminal);
+        detail::art::forEachChild(node, [](detail::byte, Entry* child) {
+                    destroy(child);
+                });
+        destroyNode(node);
+    }
+
+    Entry* root = nullptr;
+    std::size_t count = 0;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_ADAPTIVERADIXTREE_HPP
@@ -0,0 +1,193 @@
+#ifndef SERIALIZATION_BLOOMFILTER_HPP
+#define SERIALIZATION_BLOOMFILTER_HPP
+
+#include "SerialView.hpp"
+#include "detail/ByteSequence.hpp"
+#include "detail/Hash.hpp"
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// Serialized form, every integer is little-endian:
+//     header (64 bytes): "SBF1", uint32 block count, uint32 prefix size,
+//             uint8 probe count, zero padding
+//     blocks (64 bytes each)
+// Every probe of a key goes to the same block, so when the filter is mapped
+// at a 64 byte aligned address a lookup touches a single cache line.
+constexpr std::size_t BLOOM_BLOCK_SIZE = 64;
+constexpr std::size_t BLOOM_HEADER_SIZE = 64;
+constexpr std::size_t BLOOM_MAX_PROBE_COUNT = 16;
+
+inline std::size_t getBloomBlockIndex(std::uint64_t hash,
+        std::uint32_t blockCount) {
+    return static_cast<std::size_t>(((hash >> 32) * blockCount) >> 32);
+}
+
+// The bits inside of the block are taken from the low half of the hash, 9
+// bits (0-511) at a time, remixed by multiplication for every probe.
+template <typename Visitor>
+void forEachBloomBit(std::uint64_t hash, unsigned probeCount,
+        Visitor&& visitor) {
+    std::uint32_t bits = static_cast<std::uint32_t>(hash);
+    for (unsigned i = 0; i < probeCount; ++i) {
+        visitor(bits >> 23);
+        bits *= 0x9E3779B9U;
+    }
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+//============================================================================//
+
+// Collects encoded keys and builds a blocked Bloom filter from them. With a
+// nonzero prefixSize only the first prefixSize bytes of the keys are indexed
+// (e.g. 1 + sizeof(std::int32_t) for a leading tenant id), so the filter
+// answers prefix scans too. Keys shorter than that are indexed whole.
+class BloomFilterBuilder {
+public:
+    explicit BloomFilterBuilder(unsigned bitsPerKey = 10,
+            std::size_t prefixSize = 0)
+            : bitsPerKey(std::max(bitsPerKey, 1U)), prefixSize(prefixSize) {
+    }
+
+    void add(const SerialView& key) {
+        hashes.push_back(detail::hashBytes(key.data(),
+                prefixSize == 0 ? key.size() :
+                        std::min(key.size(), prefixSize)));
+    }
+
+    std::size_t size() const {
+        return hashes.size();
+    }
+
+    // Returns the serialized filter, which can be written to a file as it is.
+    detail::ByteSequence finish() const {
+        const std::uint64_t bitCount =
+                static_cast<std::uint64_t>(hashes.size()) * bitsPerKey;
+        const std::uint32_t blockCount = static_cast<std::uint32_t>(std::max<
+                std::uint64_t>((bitCount + detail::BLOOM_BLOCK_SIZE * 8 - 1) /
+                        (detail::BLOOM_BLOCK_SIZE * 8), 1));
+        // bitsPerKey * ln(2), rounded
+        const unsigned probeCount = std::max(1U, std::min<unsigned>(
+                (bitsPerKey * 69 + 50) / 100, detail::BLOOM_MAX_PROBE_COUNT));
+
+        detail::ByteSequence filter(detail::BLOOM_HEADER_SIZE +
+                blockCount * detail::BLOOM_BLOCK_SIZE);
+        std::memcpy(filter.data(), "SBF1", 4);
+        writeUint32(filter.data() + 4, blockCount);
+        writeUint32(filter.data() + 8, static_cast<std::uint32_t>(prefixSize));
+        filter[12] = static_cast<detail::byte>(probeCount);
+
+        for (std::uint64_t hash : hashes) {
+            detail::byte* block = filter.data() + detail::BLOOM_HEADER_SIZE +
+                    detail::getBloomBlockIndex(hash, blockCount) *
+                    detail::BLOOM_BLOCK_SIZE;
+            detail::forEachBloomBit(hash, probeCount, [block](unsigned bit) {
+                        block[bit >> 3] |= static_cast<detail::byte>(
+                                1U << (bit & 7));
+                    });
+        }
+        return filter;
+    }
+
+private:
+    static void writeUint32(detail::byte* output, std::uint32_t value) {
+        value = boost::endian::native_to_little(value);
+        std::memcpy(output, &value, sizeof(value));
+    }
+
+    unsigned bitsPerKey;
+    std::size_t prefixSize;
+    std::vector<std::uint64_t> hashes;
+};
+
+//----------------------------------------------------------------------------//
+
+// Reads a serialized filter in place, e.g. from a mapped file. The bytes must
+// outlive the reader. A filter which is not valid answers every query with
+// true, so it never hides a key.
+class BloomFilterReader {
+public:
+    BloomFilterReader(const detail::byte* data, std::size_t size) {
+        if (size < detail::BLOOM_HEADER_SIZE ||
+                std::memcmp(data, "SBF1", 4) != 0) {
+            return;
+        }
+        const std::uint32_t count = readUint32(data + 4);
+        if (count == 0 || data[12] == 0 ||
+                data[12] > detail::BLOOM_MAX_PROBE_COUNT ||
+                (size - detail::BLOOM_HEADER_SIZE) / detail::BLOOM_BLOCK_SIZE <
+                        count) {
+            return;
+        }
+        blocks = data + detail::BLOOM_HEADER_SIZE;
+        blockCount = count;
+        prefixSize = readUint32(data + 8);
+        probeCount = data[12];
+    }
+
+    bool isValid() const {
+        return blocks != nullptr;
+    }
+
+    std::size_t getPrefixSize() const {
+        return prefixSize;
+    }
+
+    // False if the key was surely not added.
+    bool mayContain(const SerialView& key) const {
+        return mayContainHashed(key.data(), prefixSize == 0 ? key.size() :
+                std::min(key.size(), prefixSize));
+    }
+
+    // False if there is surely no key starting with the prefix. Only prefixes
+    // at least as long as the indexed one can be filtered.
+    bool mayContainPrefix(const SerialView& prefix) const {
+        if (prefixSize == 0 || prefix.size() < prefixSize) {
+            return true;
+        }
+        return mayContainHashed(prefix.data(), prefixSize);
+    }
+
+private:
+    static std::uint32_t readUint32(const detail::byte* input) {
+        std::uint32_t value;
+        std::memcpy(&value, input, sizeof(value));
+        return boost::endian::little_to_native(value);
+    }
+
+    bool mayContainHashed(const detail::byte* data, std::size_t size) const {
+        if (!isValid()) {
+            return true;
+        }
+        const std::uint64_t hash = detail::hashBytes(data, size);
+        const detail::byte* block = blocks +
+                detail::getBloomBlockIndex(hash, blockCount) *
+                detail::BLOOM_BLOCK_SIZE;
+        bool found = true;
+        detail::forEachBloomBit(hash, probeCount, [&](unsigned bit) {
+                    found &= ((block[bit >> 3] >> (bit & 7)) & 1) != 0;
+                });
+        return found;
+    }
+
+    const detail::byte* blocks = nullptr;
+    std::uint32_t blockCount = 0;
+    std::size_t prefixSize = 0;
+    unsigned probeCount = 0;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_BLOOMFILTER_HPP
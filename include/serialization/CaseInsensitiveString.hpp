@@ -0,0 +1,45 @@
+#ifndef SERIALIZATION_CASEINSENSITIVESTRING_HPP
+#define SERIALIZATION_CASEINSENSITIVESTRING_HPP
+
+#include <string>
+#include <utility>
+
+//============================================================================//
+namespace serialization {
+//----------------------------------------------------------------------------//
+
+// A UTF-8 string which is ordered case-insensitively in serial form.
+// Serialized as a sort key: the simple case folded string (primary weights)
+// then the original string as a tie-break, both \0 terminated. Strings which
+// differ only in case are therefore adjacent, but not equal.
+class CaseInsensitiveString {
+public:
+    CaseInsensitiveString() = default;
+
+    CaseInsensitiveString(std::string value) : value(std::move(value)) {
+    }
+
+    CaseInsensitiveString(const char* value) : value(value) {
+    }
+
+    const std::string& str() const {
+        return value;
+    }
+
+    bool operator==(const CaseInsensitiveString& rhs) const {
+        return value == rhs.value;
+    }
+
+    bool operator!=(const CaseInsensitiveString& rhs) const {
+        return value != rhs.value;
+    }
+
+private:
+    std::string value;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_CASEINSENSITIVESTRING_HPP
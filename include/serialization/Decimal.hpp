@@ -0,0 +1,83 @@
+#ifndef SERIALIZATION_DECIMAL_HPP
+#define SERIALIZATION_DECIMAL_HPP
+
+#include "detail/ConversionMap.hpp"
+
+#include <boost/operators.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// The narrowest signed integer which can hold every unscaled value having
+// Precision decimal digits.
+template <unsigned Precision>
+struct DecimalStorage {
+    using type = typename std::conditional<(Precision <= 2), std::int8_t,
+            typename std::conditional<(Precision <= 4), std::int16_t,
+            typename std::conditional<(Precision <= 9), std::int32_t,
+#ifdef SERIALIZATION_HAS_INT128
+            typename std::conditional<(Precision <= 18), std::int64_t,
+                    int128_t>::type
+#else
+            std::int64_t
+#endif
+            >::type>::type>::type;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+//============================================================================//
+
+// Fixed-point decimal number with Precision significant digits, Scale of them
+// after the decimal point. The value is unscaledValue() * 10^-Scale.
+// Serialized as its unscaled integer, so it keeps its exact value and
+// compares correctly with memcmp. Every scale has a type id of its own, a
+// value is never read back with another scale.
+template <unsigned Precision, unsigned Scale>
+class Decimal : public boost::totally_ordered<Decimal<Precision, Scale>> {
+public:
+    static_assert(Precision > 0, "Precision must be positive!");
+    static_assert(Scale <= Precision, "Scale cannot exceed the precision!");
+#ifdef SERIALIZATION_HAS_INT128
+    static_assert(Precision <= 38, "Precision is too big!");
+#else
+    static_assert(Precision <= 18, "Precision is too big!");
+#endif
+
+    using Storage = typename detail::DecimalStorage<Precision>::type;
+
+    constexpr static unsigned precision = Precision;
+    constexpr static unsigned scale = Scale;
+
+    constexpr Decimal() = default;
+
+    constexpr explicit Decimal(const Storage& unscaledValue)
+            : value(unscaledValue) {
+    }
+
+    constexpr const Storage& unscaledValue() const {
+        return value;
+    }
+
+    constexpr bool operator==(const Decimal& rhs) const {
+        return value == rhs.value;
+    }
+
+    constexpr bool operator<(const Decimal& rhs) const {
+        return value < rhs.value;
+    }
+
+private:
+    Storage value = 0;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_DECIMAL_HPP
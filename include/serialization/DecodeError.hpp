@@ -0,0 +1,22 @@
+#ifndef SERIALIZATION_DECODEERROR_HPP
+#define SERIALIZATION_DECODEERROR_HPP
+
+//============================================================================//
+namespace serialization {
+//----------------------------------------------------------------------------//
+
+// Result of the checked decoding of untrusted data, see Serial::validate().
+enum class DecodeError {
+    none,
+    truncated,           // a field is cut off at the end of the data
+    unterminatedString,  // a string has no \0 terminator
+    unknownTypeId,       // a type tag which is not known by the Serial
+    invalidData,         // a field has an impossible value
+    typeMismatch         // the next field is not of the type being read
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_DECODEERROR_HPP
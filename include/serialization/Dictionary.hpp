@@ -0,0 +1,139 @@
+#ifndef SERIALIZATION_DICTIONARY_HPP
+#define SERIALIZATION_DICTIONARY_HPP
+
+#include "DecodeError.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+//============================================================================//
+namespace serialization {
+//----------------------------------------------------------------------------//
+
+// The code of a string in an OrderPreservingDictionary. Strings found in the
+// dictionary get odd codes (2 * index + 1). A string missing from the
+// dictionary gets the even code between its neighbours and is stored as it is
+// after the code, hence the codes compare exactly like the strings do.
+class DictionaryCode {
+public:
+    DictionaryCode() = default;
+
+    explicit DictionaryCode(std::uint32_t code, std::string missingValue = {})
+            : code(code), missingValue(std::move(missingValue)) {
+    }
+
+    std::uint32_t value() const {
+        return code;
+    }
+
+    bool isFound() const {
+        return code % 2 == 1;
+    }
+
+    std::size_t index() const {
+        return code / 2;
+    }
+
+    // Valid only if the string was not found in the dictionary.
+    const std::string& getMissingValue() const {
+        return missingValue;
+    }
+
+    bool operator==(const DictionaryCode& rhs) const {
+        return code == rhs.code && missingValue == rhs.missingValue;
+    }
+
+    bool operator!=(const DictionaryCode& rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+    std::uint32_t code = 0;
+    std::string missingValue;
+};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+// Sorted dictionary of the values of a low-cardinality string column, built
+// from a sample or the full column. Codes are packed in 1-4 bytes (see
+// detail::encodeOrderedVarint), so a country or a status name costs a single
+// byte in a serial instead of the whole string.
+class OrderPreservingDictionary {
+public:
+    constexpr static std::size_t MAX_SIZE = (1U << 27) - 1;
+
+    OrderPreservingDictionary() = default;
+
+    template <typename InputIterator>
+    OrderPreservingDictionary(InputIterator first, InputIterator last)
+            : OrderPreservingDictionary(std::vector<std::string>(first, last)) {
+    }
+
+    explicit OrderPreservingDictionary(std::vector<std::string> values)
+            : values(std::move(values)) {
+        std::sort(this->values.begin(), this->values.end());
+        this->values.erase(std::unique(this->values.begin(),
+                this->values.end()), this->values.end());
+        BOOST_ASSERT_MSG(this->values.size() <= MAX_SIZE,
+                "Too many values for a dictionary.");
+    }
+
+    DictionaryCode encode(const std::string& value) const {
+        const auto position = std::lower_bound(values.begin(), values.end(),
+                value);
+        const std::uint32_t index = static_cast<std::uint32_t>(
+                std::distance(values.begin(), position));
+        if (position != values.end() && *position == value) {
+            return DictionaryCode{2 * index + 1};
+        }
+        return DictionaryCode{2 * index, value};
+    }
+
+    const std::string& decode(const DictionaryCode& code) const {
+        if (!code.isFound()) {
+            return code.getMissingValue();
+        }
+        BOOST_ASSERT_MSG(contains(code), "Code is not in the dictionary.");
+        return values[code.index()];
+    }
+
+    // The checked counterpart of decode() for codes of untrusted data. A code
+    // which is not in the dictionary gives invalidData and leaves the value
+    // unchanged.
+    DecodeError decode(const DictionaryCode& code, std::string& value) const {
+        if (!contains(code)) {
+            return DecodeError::invalidData;
+        }
+        value = decode(code);
+        return DecodeError::none;
+    }
+
+    // Missing values are always decodable.
+    bool contains(const DictionaryCode& code) const {
+        return !code.isFound() || code.index() < values.size();
+    }
+
+    std::size_t size() const {
+        return values.size();
+    }
+
+    // The sorted values, e.g. to persist the dictionary.
+    const std::vector<std::string>& getValues() const {
+        return values;
+    }
+
+private:
+    std::vector<std::string> values;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_DICTIONARY_HPP
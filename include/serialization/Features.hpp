@@ -11,6 +11,12 @@ struct StronglyTypedIntegers;
 
 struct CompressedIntegers;
 
+//----------------------------------------------------------------------------//
+
+// Not comparable: little-endian, untagged, length-prefixed strings. For the
+// values (payloads) of records, see Payload.hpp.
+struct CompactPayload;
+
 //----------------------------------------------------------------------------//
 } // namespace serialization
 //============================================================================//
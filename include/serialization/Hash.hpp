@@ -0,0 +1,125 @@
+#ifndef SERIALIZATION_HASH_HPP
+#define SERIALIZATION_HASH_HPP
+
+#include "SerialView.hpp"
+#include "Sequentialize.hpp"
+#include "detail/ByteSequence.hpp"
+#include "detail/Hash.hpp"
+
+#include <boost/operators.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+//============================================================================//
+namespace serialization {
+//----------------------------------------------------------------------------//
+
+inline std::uint64_t hash(const SerialView& key, std::uint64_t seed = 0) {
+    return detail::hashBytes(key.data(), key.size(), seed);
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+// A finished key together with its hash, which is computed once when the key
+// is built. Meant for keys probed many times, e.g. those of an unordered
+// container. It cannot change, so it can be shared between threads.
+template <typename Serial>
+class HashedKey : public boost::totally_ordered<HashedKey<Serial>> {
+public:
+    explicit HashedKey(Serial&& serial)
+            : serial(std::move(serial)), keyHash(this->serial.hash()) {
+    }
+
+    HashedKey(const HashedKey&) = delete;
+    HashedKey& operator=(const HashedKey&) = delete;
+
+    // The moved from key is left with the hash of its remaining bytes.
+    HashedKey(HashedKey&& other)
+            : serial(std::move(other.serial)), keyHash(other.keyHash) {
+        other.keyHash = other.serial.hash();
+    }
+
+    HashedKey& operator=(HashedKey&& other) {
+        serial = std::move(other.serial);
+        keyHash = other.keyHash;
+        other.keyHash = other.serial.hash();
+        return *this;
+    }
+
+    const Serial& get() const {
+        return serial;
+    }
+
+    const detail::byte* data() const {
+        return serial.data();
+    }
+
+    std::size_t size() const {
+        return serial.size();
+    }
+
+    std::uint64_t hash() const {
+        return keyHash;
+    }
+
+    bool operator==(const HashedKey& rhs) const {
+        return keyHash == rhs.keyHash && serial == rhs.serial;
+    }
+
+    bool operator<(const HashedKey& rhs) const {
+        return serial < rhs.serial;
+    }
+
+private:
+    Serial serial;
+    std::uint64_t keyHash;
+};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+// Hasher for unordered containers of Serials, HashedKeys or SerialViews. Only
+// HashedKeys are not hashed again. It is not transparent: std::unordered_*
+// ignore that before C++20, so looking up needs a key of the stored type.
+struct SerialHash {
+    template <typename Serial>
+    std::size_t operator()(const HashedKey<Serial>& key) const {
+        return static_cast<std::size_t>(key.hash());
+    }
+
+    std::size_t operator()(const SerialView& key) const {
+        return static_cast<std::size_t>(hash(key));
+    }
+};
+
+//----------------------------------------------------------------------------//
+
+// Hashes count keys stored back to back in buffer. Key i is between
+// offsets[i] and offsets[i + 1], so there are count + 1 offsets.
+// The seed is mixed once for the whole batch. The hashes do not depend on
+// each other, so the multiplications of several keys are in flight at the
+// same time and the buffer is read sequentially.
+inline void hashBatch(const detail::byte* buffer, const std::size_t* offsets,
+        std::size_t count, std::uint64_t* hashes, std::uint64_t seed = 0) {
+    const std::uint64_t mixedSeed = detail::mixSeed(seed);
+    for (std::size_t i = 0; i < count; ++i) {
+        hashes[i] = detail::hashBytesWithMixedSeed(buffer + offsets[i],
+                offsets[i + 1] - offsets[i], mixedSeed);
+    }
+}
+
+inline void hashBatch(const SerialView* keys, std::size_t count,
+        std::uint64_t* hashes, std::uint64_t seed = 0) {
+    const std::uint64_t mixedSeed = detail::mixSeed(seed);
+    for (std::size_t i = 0; i < count; ++i) {
+        hashes[i] = detail::hashBytesWithMixedSeed(keys[i].data(),
+                keys[i].size(), mixedSeed);
+    }
+}
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_HASH_HPP
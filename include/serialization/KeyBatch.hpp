@@ -0,0 +1,271 @@
+#ifndef SERIALIZATION_KEYBATCH_HPP
+#define SERIALIZATION_KEYBATCH_HPP
+
+#include "DecodeError.hpp"
+#include "SerialView.hpp"
+#include "detail/ByteSequence.hpp"
+#include "detail/OrderPreserving.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// Every key of a batch is stored relative to the previous one (the first one
+// to an empty key) as
+//     ordered varint: the size of the prefix shared with the previous key
+//     ordered varint: 2 * suffix size + delta flag
+//     suffix:         the rest of the key, or if the delta flag is set, the
+//                     ordered varint difference of the suffix and the
+//                     previous key's suffix read as big-endian integers
+// Deltas are used for suffixes of at most 8 bytes, e.g. the changing bytes of
+// an integer field at the end of keys having the same size.
+constexpr std::size_t MAX_DELTA_SUFFIX_SIZE = sizeof(std::uint64_t);
+
+inline std::uint64_t readBigEndianSuffix(const byte* data, std::size_t size) {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+inline void writeBigEndianSuffix(byte* data, std::size_t size,
+        std::uint64_t value) {
+    for (std::size_t i = size; i > 0; --i) {
+        data[i - 1] = static_cast<byte>(value);
+        value >>= 8;
+    }
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+//============================================================================//
+
+// Encodes a sorted run of keys into the batch format above.
+class KeyBatchEncoder {
+public:
+    explicit KeyBatchEncoder(bool deltaIntegers = false)
+            : deltaIntegers(deltaIntegers) {
+    }
+
+    // Keys must be added in order.
+    void add(const SerialView& key) {
+        const SerialView previousKey{previous.data(), previousSize};
+        BOOST_ASSERT_MSG(!(key < previousKey), "Keys must be sorted.");
+        BOOST_ASSERT_MSG(key.size() <= detail::MAX_ORDERED_VARINT / 2,
+                "Key is too long.");
+        const std::size_t shared = detail::getCommonPrefixSize(
+                previousKey.data(), previousKey.size(), key.data(),
+                key.size());
+        const std::size_t suffixSize = key.size() - shared;
+
+        // The buffers only grow, the sizes are tracked separately, so that
+        // adding a key does not initialize or shrink them.
+        ensureSize(output, outputSize + 2 * detail::MAX_ORDERED_VARINT_SIZE +
+                suffixSize);
+        detail::byte* position = output.data() + outputSize;
+        position += detail::encodeOrderedVarint(
+                static_cast<std::uint32_t>(shared), position);
+
+        std::uint64_t delta = 0;
+        if (deltaIntegers && key.size() == previousSize &&
+                suffixSize > 1 && suffixSize <= detail::MAX_DELTA_SUFFIX_SIZE) {
+            delta = detail::readBigEndianSuffix(key.data() + shared,
+                    suffixSize) - detail::readBigEndianSuffix(
+                            previous.data() + shared, suffixSize);
+        }
+        detail::byte deltaBytes[detail::MAX_ORDERED_VARINT_SIZE];
+        const std::size_t deltaSize = delta == 0 ||
+                delta > detail::MAX_ORDERED_VARINT ? 0 :
+                detail::encodeOrderedVarint(static_cast<std::uint32_t>(delta),
+                        deltaBytes);
+
+        if (deltaSize != 0 && deltaSize < suffixSize) {
+            position += detail::encodeOrderedVarint(
+                    static_cast<std::uint32_t>(suffixSize * 2 + 1), position);
+            std::memcpy(position, deltaBytes, deltaSize);
+            position += deltaSize;
+        } else {
+            position += detail::encodeOrderedVarint(
+                    static_cast<std::uint32_t>(suffixSize * 2), position);
+            if (suffixSize != 0) {
+                std::memcpy(position, key.data() + shared, suffixSize);
+            }
+            position += suffixSize;
+        }
+        outputSize = position - output.data();
+
+        ensureSize(previous, key.size());
+        if (suffixSize != 0) {
+            std::memcpy(previous.data() + shared, key.data() + shared,
+                    suffixSize);
+        }
+        previousSize = key.size();
+        ++count;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    SerialView getBytes() const {
+        return SerialView{output.data(), outputSize};
+    }
+
+    // Moves the encoded batch out and starts a new one.
+    detail::ByteSequence finish() {
+        output.resize(outputSize);
+        detail::ByteSequence result = std::move(output);
+        output.clear();
+        reset();
+        return result;
+    }
+
+    // Starts a new batch, keeping the allocated memory.
+    void reset() {
+        outputSize = 0;
+        previousSize = 0;
+        count = 0;
+    }
+
+private:
+    static void ensureSize(detail::ByteSequence& sequence, std::size_t size) {
+        if (sequence.size() < size) {
+            sequence.resize(std::max(size, sequence.size() * 2));
+        }
+    }
+
+    bool deltaIntegers;
+    detail::ByteSequence output;
+    std::size_t outputSize = 0;
+    detail::ByteSequence previous;
+    std::size_t previousSize = 0;
+    std::size_t count = 0;
+};
+
+//----------------------------------------------------------------------------//
+
+// Decodes a batch one key at a time. The data may come from the network, so
+// it is checked: decoding stops at the first problem, which is kept in
+// getDecodeError().
+class KeyBatchDecoder {
+public:
+    KeyBatchDecoder(const detail::byte* data, std::size_t size)
+            : position(data), end(data + size) {
+    }
+
+    // The view is valid until the next call.
+    bool next(SerialView& key) {
+        if (!decodeNext()) {
+            return false;
+        }
+        key = SerialView{current};
+        return true;
+    }
+
+    // Copies the key into a reused Serial, which does not allocate once it is
+    // big enough.
+    template <typename Serial>
+    bool next(Serial& key) {
+        if (!decodeNext()) {
+            return false;
+        }
+        detail::ByteSequence bytes = key.release();
+        bytes.assign(current.begin(), current.end());
+        key.adopt(std::move(bytes));
+        return true;
+    }
+
+    bool isExhausted() const {
+        return position == end;
+    }
+
+    DecodeError getDecodeError() const {
+        return decodeError;
+    }
+
+private:
+    bool readVarint(std::uint32_t& value) {
+        if (position == end) {
+            return fail(DecodeError::truncated);
+        }
+        const std::size_t size = detail::getOrderedVarintSize(*position);
+        if (size == 0) {
+            return fail(DecodeError::invalidData);
+        }
+        if (size > static_cast<std::size_t>(end - position)) {
+            return fail(DecodeError::truncated);
+        }
+        value = detail::decodeOrderedVarint(position);
+        position += size;
+        return true;
+    }
+
+    bool decodeNext() {
+        if (decodeError != DecodeError::none || position == end) {
+            return false;
+        }
+        std::uint32_t shared = 0;
+        std::uint32_t suffix = 0;
+        if (!readVarint(shared) || !readVarint(suffix)) {
+            return false;
+        }
+        const std::size_t suffixSize = suffix / 2;
+        if (shared > current.size()) {
+            return fail(DecodeError::invalidData);
+        }
+
+        if (suffix % 2 == 0) {
+            if (suffixSize > static_cast<std::size_t>(end - position)) {
+                return fail(DecodeError::truncated);
+            }
+            current.resize(shared);
+            current.insert(current.end(), position, position + suffixSize);
+            position += suffixSize;
+            return true;
+        }
+
+        if (shared + suffixSize != current.size() ||
+                suffixSize > detail::MAX_DELTA_SUFFIX_SIZE) {
+            return fail(DecodeError::invalidData);
+        }
+        std::uint32_t delta = 0;
+        if (!readVarint(delta)) {
+            return false;
+        }
+        const std::uint64_t previous = detail::readBigEndianSuffix(
+                current.data() + shared, suffixSize);
+        const std::uint64_t value = previous + delta;
+        if (value < previous || (suffixSize < sizeof(value) &&
+                value >> (suffixSize * 8) != 0)) {
+            return fail(DecodeError::invalidData);
+        }
+        detail::writeBigEndianSuffix(current.data() + shared, suffixSize,
+                value);
+        return true;
+    }
+
+    bool fail(DecodeError error) {
+        decodeError = error;
+        return false;
+    }
+
+    const detail::byte* position;
+    const detail::byte* end;
+    detail::ByteSequence current;
+    DecodeError decodeError = DecodeError::none;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_KEYBATCH_HPP
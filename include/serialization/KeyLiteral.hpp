@@ -0,0 +1,65 @@
+#ifndef SERIALIZATION_KEYLITERAL_HPP
+#define SERIALIZATION_KEYLITERAL_HPP
+
+#include "Features.hpp"
+#include "Sequentialize.hpp"
+#include "detail/ByteSequence.hpp"
+#include "detail/ConversionMap.hpp"
+#include "detail/FixedWidth.hpp"
+#include "detail/TypeId.hpp"
+#include "detail/TypeTraits.hpp"
+
+#include <array>
+#include <cstddef>
+
+#if __cplusplus < 201703L
+#error "Keys encoded at compile time need C++17 (constexpr std::array)."
+#endif
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+template <typename FixedWidth>
+constexpr std::size_t getKeyFieldSize() {
+    static_assert(IsFixedWidth<FixedWidth>::value,
+            "Only fixed width types can be encoded at compile time!");
+    return getTypeIdSize(PackableTypeId<FixedWidth>::value) +
+            sizeof(typename PackedValueOf<FixedWidth>::type);
+}
+
+template <typename FixedWidth>
+constexpr byte* packKeyField(const FixedWidth& value, byte* output) {
+    output += encodeTypeId(PackableTypeId<FixedWidth>::value, output);
+    return Sequentializer<StronglyTypedIntegers>::packFixedWidth(value,
+            output);
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+//============================================================================//
+
+// The bytes a Serial would have after packing the values, computed at compile
+// time for constant keys (e.g. a tenant prefix or a seek bound). Floating
+// point values are only encoded at run time.
+//
+//     constexpr auto prefix = encodeKey(std::int8_t{3}, std::int32_t{42});
+//     auto it = keys.lower_bound(SerialView{prefix});
+template <typename... FixedWidths>
+constexpr std::array<detail::byte,
+        (detail::getKeyFieldSize<FixedWidths>() + ... + 0)>
+encodeKey(const FixedWidths&... values) {
+    std::array<detail::byte,
+            (detail::getKeyFieldSize<FixedWidths>() + ... + 0)> key{};
+    detail::byte* output = key.data();
+    ((output = detail::packKeyField(values, output)), ...);
+    static_cast<void>(output);
+    return key;
+}
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_KEYLITERAL_HPP
@@ -0,0 +1,142 @@
+#ifndef SERIALIZATION_KEYPREFIXNODE_HPP
+#define SERIALIZATION_KEYPREFIXNODE_HPP
+
+#include "SerialView.hpp"
+#include "detail/ByteSequence.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// The first 8 bytes of a key (padded with zeros) as an integer which
+// compares the same way as the bytes do. The sign bit is flipped so that the
+// prefixes can be compared by signed SIMD instructions.
+inline std::int64_t getNormalizedPrefix(const byte* data, std::size_t size) {
+    std::uint64_t prefix = 0;
+    if (size != 0) {
+        std::memcpy(&prefix, data, std::min(size, sizeof(prefix)));
+    }
+    return static_cast<std::int64_t>(boost::endian::big_to_native(prefix) ^
+            (static_cast<std::uint64_t>(1) << 63));
+}
+
+//----------------------------------------------------------------------------//
+
+// Returns how many prefixes are less than, and less than or equal to, the
+// probe. The prefixes are scanned without branches.
+inline std::pair<std::size_t, std::size_t> countPrefixes(
+        const std::int64_t* prefixes, std::size_t size, std::int64_t probe) {
+    std::size_t less = 0;
+    std::size_t lessOrEqual = 0;
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i probes = _mm256_set1_epi64x(probe);
+    for (; i + 4 <= size; i += 4) {
+        const __m256i chunk = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(prefixes + i));
+        const int greaterMask = _mm256_movemask_pd(_mm256_castsi256_pd(
+                _mm256_cmpgt_epi64(chunk, probes)));
+        const int lessMask = _mm256_movemask_pd(_mm256_castsi256_pd(
+                _mm256_cmpgt_epi64(probes, chunk)));
+        less += __builtin_popcount(lessMask);
+        lessOrEqual += 4 - __builtin_popcount(greaterMask);
+    }
+#elif defined(__SSE4_2__)
+    const __m128i probes = _mm_set1_epi64x(probe);
+    for (; i + 2 <= size; i += 2) {
+        const __m128i chunk = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(prefixes + i));
+        const int greaterMask = _mm_movemask_pd(_mm_castsi128_pd(
+                _mm_cmpgt_epi64(chunk, probes)));
+        const int lessMask = _mm_movemask_pd(_mm_castsi128_pd(
+                _mm_cmpgt_epi64(probes, chunk)));
+        less += __builtin_popcount(lessMask);
+        lessOrEqual += 2 - __builtin_popcount(greaterMask);
+    }
+#endif
+    for (; i < size; ++i) {
+        less += prefixes[i] < probe;
+        lessOrEqual += prefixes[i] <= probe;
+    }
+    return {less, lessOrEqual};
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+//============================================================================//
+
+// Sorted keys of an index node (e.g. a B-tree page) for searching. The
+// normalized 8 byte prefixes are stored in one packed array which is scanned
+// with AVX2 or SSE4.2 when available. The whole keys are only compared when
+// the prefixes are equal. The keys are not owned: they point into the node.
+class KeyPrefixNode {
+public:
+    KeyPrefixNode() = default;
+
+    template <typename InputIterator>
+    KeyPrefixNode(InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    // Keys must be appended in order.
+    void push_back(const SerialView& key) {
+        BOOST_ASSERT_MSG(keys.empty() || !(key < keys.back()),
+                "Keys must be sorted.");
+        prefixes.push_back(detail::getNormalizedPrefix(key.data(),
+                key.size()));
+        keys.push_back(key);
+    }
+
+    void clear() {
+        prefixes.clear();
+        keys.clear();
+    }
+
+    // The index of the first key which is not less than the probe.
+    std::size_t lowerBound(const SerialView& probe) const {
+        const std::pair<std::size_t, std::size_t> counts =
+                detail::countPrefixes(prefixes.data(), prefixes.size(),
+                        detail::getNormalizedPrefix(probe.data(),
+                                probe.size()));
+        if (counts.first == counts.second) {
+            return counts.first;
+        }
+        return std::lower_bound(keys.begin() + counts.first,
+                       keys.begin() + counts.second, probe) - keys.begin();
+    }
+
+    std::size_t size() const {
+        return keys.size();
+    }
+
+    const SerialView& operator[](std::size_t index) const {
+        return keys[index];
+    }
+
+private:
+    std::vector<std::int64_t> prefixes;
+    std::vector<SerialView> keys;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_KEYPREFIXNODE_HPP
@@ -0,0 +1,156 @@
+#ifndef SERIALIZATION_PARTITIONING_HPP
+#define SERIALIZATION_PARTITIONING_HPP
+
+#include "KeyPrefixNode.hpp"
+#include "SerialView.hpp"
+#include "detail/ByteSequence.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//============================================================================//
+namespace serialization {
+//----------------------------------------------------------------------------//
+
+// Splits the key space into ranges at the given (sorted) boundary keys:
+// partition i holds the keys in [boundaries[i - 1], boundaries[i]). The keys
+// are looked up by the normalized 8 byte prefixes of the boundaries first
+// (see KeyPrefixNode), whole keys are only compared on equal prefixes.
+class RangePartitioner {
+public:
+    RangePartitioner() = default;
+
+    explicit RangePartitioner(std::vector<detail::ByteSequence> boundaries)
+            : boundaries(std::move(boundaries)) {
+        BOOST_ASSERT_MSG(std::is_sorted(this->boundaries.begin(),
+                this->boundaries.end(), SerialLess{}),
+                "Boundaries must be sorted.");
+        prefixes.reserve(this->boundaries.size());
+        for (const detail::ByteSequence& boundary : this->boundaries) {
+            prefixes.push_back(detail::getNormalizedPrefix(boundary.data(),
+                    boundary.size()));
+        }
+    }
+
+    std::size_t getPartitionCount() const {
+        return boundaries.size() + 1;
+    }
+
+    const std::vector<detail::ByteSequence>& getBoundaries() const {
+        return boundaries;
+    }
+
+    std::size_t getPartition(const SerialView& key) const {
+        const std::pair<std::size_t, std::size_t> counts =
+                detail::countPrefixes(prefixes.data(), prefixes.size(),
+                        detail::getNormalizedPrefix(key.data(), key.size()));
+        if (counts.first == counts.second) {
+            return counts.first;
+        }
+        return std::upper_bound(boundaries.begin() + counts.first,
+                       boundaries.begin() + counts.second, key, SerialLess{}) -
+                boundaries.begin();
+    }
+
+private:
+    std::vector<detail::ByteSequence> boundaries;
+    std::vector<std::int64_t> prefixes;
+};
+
+//----------------------------------------------------------------------------//
+
+// Uniform random sample of a stream of encoded keys with a fixed capacity
+// (reservoir sampling, Li's algorithm L). The number of keys to skip until
+// the next replacement is drawn at once, so a key which is not sampled costs
+// a single comparison. The sampled keys are copied as they are, no decoding
+// is needed.
+class KeySampler {
+public:
+    explicit KeySampler(std::size_t capacity, std::uint64_t seed = 0)
+            : capacity(capacity), randomState(seed) {
+        BOOST_ASSERT_MSG(capacity > 0, "Capacity must be positive.");
+        sample.reserve(capacity);
+        weight = std::exp(std::log(getRandom()) / capacity);
+        nextIndex = capacity - 1;
+        skip();
+    }
+
+    void add(const SerialView& key) {
+        if (sample.size() < capacity) {
+            sample.emplace_back(key.data(), key.data() + key.size());
+        } else if (seenCount == nextIndex) {
+            // The replaced key's memory is reused.
+            sample[static_cast<std::size_t>(getRandom() * capacity)].assign(
+                    key.data(), key.data() + key.size());
+            weight *= std::exp(std::log(getRandom()) / capacity);
+            skip();
+        }
+        ++seenCount;
+    }
+
+    // The number of keys added so far.
+    std::uint64_t getSeenCount() const {
+        return seenCount;
+    }
+
+    const std::vector<detail::ByteSequence>& getSample() const {
+        return sample;
+    }
+
+    // Boundaries which split the sampled keys into partitionCount (nearly)
+    // equal parts. Equal boundaries are merged, so a heavy key gives fewer
+    // partitions.
+    RangePartitioner computePartitioner(std::size_t partitionCount) const {
+        BOOST_ASSERT_MSG(partitionCount > 0, "No partitions.");
+        std::vector<SerialView> sorted(sample.begin(), sample.end());
+        std::sort(sorted.begin(), sorted.end());
+        std::vector<detail::ByteSequence> boundaries;
+        if (!sorted.empty()) {
+            for (std::size_t i = 1; i < partitionCount; ++i) {
+                const SerialView& boundary =
+                        sorted[i * sorted.size() / partitionCount];
+                if (boundaries.empty() ||
+                        SerialView{boundaries.back()} < boundary) {
+                    boundaries.emplace_back(boundary.data(),
+                            boundary.data() + boundary.size());
+                }
+            }
+        }
+        return RangePartitioner{std::move(boundaries)};
+    }
+
+private:
+    // splitmix64, mapped into (0, 1)
+    double getRandom() {
+        std::uint64_t value = (randomState += 0x9E3779B97F4A7C15ULL);
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        value ^= value >> 31;
+        return (static_cast<double>(value >> 11) + 0.5) /
+                static_cast<double>(std::uint64_t{1} << 53);
+    }
+
+    // Draws the index of the next key to be sampled.
+    void skip() {
+        nextIndex += static_cast<std::uint64_t>(
+                std::log(getRandom()) / std::log1p(-weight)) + 1;
+    }
+
+    std::size_t capacity;
+    std::vector<detail::ByteSequence> sample;
+    std::uint64_t seenCount = 0;
+    std::uint64_t nextIndex = 0;
+    double weight = 0;
+    std::uint64_t randomState;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_PARTITIONING_HPP
@@ -0,0 +1,183 @@
+#ifndef SERIALIZATION_PAYLOAD_HPP
+#define SERIALIZATION_PAYLOAD_HPP
+
+#include "CaseInsensitiveString.hpp"
+#include "Dictionary.hpp"
+#include "Features.hpp"
+#include "Serial.hpp"
+#include "Sequentialize.hpp"
+#include "TypeList.hpp"
+#include "detail/ByteSequence.hpp"
+#include "detail/FixedWidth.hpp"
+#include "detail/OrderPreserving.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+//============================================================================//
+namespace serialization {
+//----------------------------------------------------------------------------//
+
+// Values which are never compared need neither type tags nor order
+// preserving encodings: numbers are stored as they are in little-endian,
+// strings are prefixed by their size instead of being terminated, and case
+// insensitive strings are stored only once.
+template <>
+class Sequentializer<CompactPayload> : public detail::PackableByteSequence {
+public:
+    using PackableByteSequence::PackableByteSequence;
+
+    constexpr static bool hasTypeTags = false;
+
+    template <typename FixedWidth>
+    void pack(const FixedWidth& value) {
+        static_assert(detail::IsFixedWidth<FixedWidth>::value,
+                "Cannot pack this type!");
+        appendToSequence(boost::endian::native_to_little(encode(value)));
+    }
+
+    // Writes the same bytes as pack() to output, which has room for them,
+    // and returns the end.
+    template <typename FixedWidth>
+    static detail::byte* packFixedWidth(const FixedWidth& value,
+            detail::byte* output) {
+        const auto packedValue = boost::endian::native_to_little(
+                encode(value));
+        std::memcpy(output, &packedValue, sizeof(packedValue));
+        return output + sizeof(packedValue);
+    }
+
+    void pack(const std::string& value) {
+        BOOST_ASSERT_MSG(value.size() <= detail::MAX_ORDERED_VARINT,
+                "String is too long.");
+        packSize(static_cast<std::uint32_t>(value.size()));
+        appendToSequence(reinterpret_cast<const detail::byte*>(value.data()),
+                value.size());
+    }
+
+    void pack(const CaseInsensitiveString& value) {
+        pack(value.str());
+    }
+
+    void pack(const DictionaryCode& value) {
+        BOOST_ASSERT_MSG(value.value() <= detail::MAX_ORDERED_VARINT,
+                "Dictionary code is too big.");
+        packSize(value.value());
+        if (!value.isFound()) {
+            pack(value.getMissingValue());
+        }
+    }
+
+    template <typename FixedWidth>
+    void unpack(FixedWidth& value) {
+        static_assert(detail::IsFixedWidth<FixedWidth>::value,
+                "Cannot unpack this type!");
+        decode(boost::endian::little_to_native(readFromSequence<
+                typename detail::PackedValueOf<FixedWidth>::type>()), value);
+    }
+
+    // Payloads cannot be validated, see Serial::validate().
+    template <typename Packable>
+    bool unpackChecked(Packable& value) {
+        unpack(value);
+        return true;
+    }
+
+    template <typename FixedWidth>
+    static const detail::byte* unpackFixedWidth(const detail::byte* input,
+            FixedWidth& value) {
+        typename detail::PackedValueOf<FixedWidth>::type packedValue;
+        std::memcpy(&packedValue, input, sizeof(packedValue));
+        decode(boost::endian::little_to_native(packedValue), value);
+        return input + sizeof(packedValue);
+    }
+
+    void unpack(std::string& value) {
+        const std::size_t size = unpackSize();
+        value.assign(reinterpret_cast<const char*>(readFromSequence(size)),
+                size);
+    }
+
+    void unpack(CaseInsensitiveString& value) {
+        std::string string;
+        unpack(string);
+        value = CaseInsensitiveString{std::move(string)};
+    }
+
+    void unpack(DictionaryCode& value) {
+        const std::uint32_t code = unpackSize();
+        std::string missingValue;
+        if (code % 2 == 0) {
+            unpack(missingValue);
+        }
+        value = DictionaryCode{code, std::move(missingValue)};
+    }
+
+private:
+    // Numbers keep their own bits, the other fixed width types (decimals,
+    // durations) use their key encoding.
+    template <typename FixedWidth>
+    static typename std::enable_if<std::is_arithmetic<FixedWidth>::value,
+            typename detail::PackedValueOf<FixedWidth>::type>::type
+    encode(const FixedWidth& value) {
+        typename detail::PackedValueOf<FixedWidth>::type packedValue;
+        static_assert(sizeof(packedValue) == sizeof(value), "Size mismatch!");
+        std::memcpy(&packedValue, &value, sizeof(value));
+        return packedValue;
+    }
+
+    template <typename FixedWidth>
+    static typename std::enable_if<!std::is_arithmetic<FixedWidth>::value,
+            typename detail::PackedValueOf<FixedWidth>::type>::type
+    encode(const FixedWidth& value) {
+        return detail::FixedWidthCodec<FixedWidth>::encode(value);
+    }
+
+    template <typename FixedWidth, typename PackedValue>
+    static typename std::enable_if<std::is_arithmetic<FixedWidth>::value>::type
+    decode(const PackedValue& packedValue, FixedWidth& value) {
+        std::memcpy(&value, &packedValue, sizeof(value));
+    }
+
+    template <typename FixedWidth, typename PackedValue>
+    static typename std::enable_if<!std::is_arithmetic<FixedWidth>::value>::type
+    decode(const PackedValue& packedValue, FixedWidth& value) {
+        value = detail::FixedWidthCodec<FixedWidth>::decode(packedValue);
+    }
+
+    void packSize(std::uint32_t size) {
+        detail::byte output[detail::MAX_ORDERED_VARINT_SIZE];
+        appendToSequence(output, detail::encodeOrderedVarint(size, output));
+    }
+
+    std::uint32_t unpackSize() {
+        detail::byte input[detail::MAX_ORDERED_VARINT_SIZE];
+        input[0] = readFromSequence<detail::byte>();
+        const std::size_t size = detail::getOrderedVarintSize(input[0]);
+        BOOST_ASSERT_MSG(size != 0, "Invalid data in sequence.");
+        if (size > 1) {
+            std::memcpy(input + 1, readFromSequence(size - 1), size - 1);
+        }
+        return detail::decodeOrderedVarint(input);
+    }
+};
+
+//----------------------------------------------------------------------------//
+
+// A Serial for values: the same operators and the same serialize() and
+// deserialize() hooks of the registered types are used as for keys. Hooks
+// which shall work for both are templates on the Serial type.
+template <typename SerializableData = TypeList<>>
+using Payload = Serial<SerializableData, CompactPayload>;
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_PAYLOAD_HPP
@@ -0,0 +1,156 @@
+#ifndef SERIALIZATION_RECORD_HPP
+#define SERIALIZATION_RECORD_HPP
+
+#include "Payload.hpp"
+#include "Serial.hpp"
+#include "SerialView.hpp"
+#include "TypeList.hpp"
+#include "detail/ByteSequence.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// A record is the key, the payload, then the size of the key (uint32,
+// little-endian). The size comes last so that the key is written in place and
+// holds nothing but the key bytes.
+constexpr std::size_t RECORD_TRAILER_SIZE = sizeof(std::uint32_t);
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+//============================================================================//
+
+// Writes the key and then the payload of a record into the same buffer: the
+// payload is appended right after the key, nothing is copied.
+//
+//     builder.key() << tenant << id;
+//     builder.payload() << name << amount;
+//     SerialView record = builder.getRecord();
+template <typename SerializableData = TypeList<>>
+class RecordBuilder {
+public:
+    using Key = Serial<SerializableData>;
+    using Value = Payload<SerializableData>;
+
+    // The key has to be written first.
+    Key& key() {
+        BOOST_ASSERT_MSG(!writingPayload, "The key is already finished.");
+        return keySerial;
+    }
+
+    Value& payload() {
+        if (!writingPayload) {
+            keySize = static_cast<std::uint32_t>(keySerial.size());
+            payloadSerial.adopt(keySerial.release());
+            writingPayload = true;
+        } else if (sealed) {
+            detail::ByteSequence bytes = payloadSerial.release();
+            bytes.resize(bytes.size() - detail::RECORD_TRAILER_SIZE);
+            payloadSerial.adopt(std::move(bytes));
+            sealed = false;
+        }
+        return payloadSerial;
+    }
+
+    // Valid until the builder is changed.
+    SerialView getRecord() {
+        seal();
+        return SerialView{payloadSerial.data(), payloadSerial.size()};
+    }
+
+    // Moves the record out, the next one will allocate.
+    detail::ByteSequence finish() {
+        seal();
+        detail::ByteSequence record = payloadSerial.release();
+        clear();
+        return record;
+    }
+
+    // Starts the next record keeping the allocated memory.
+    void clear() {
+        detail::ByteSequence bytes = writingPayload ?
+                payloadSerial.release() : keySerial.release();
+        bytes.clear();
+        keySerial.adopt(std::move(bytes));
+        writingPayload = false;
+        sealed = false;
+    }
+
+private:
+    // Appends the key size once the payload is complete.
+    void seal() {
+        payload();
+        const std::uint32_t trailer =
+                boost::endian::native_to_little(keySize);
+        detail::ByteSequence bytes = payloadSerial.release();
+        const std::size_t size = bytes.size();
+        bytes.resize(size + detail::RECORD_TRAILER_SIZE);
+        std::memcpy(bytes.data() + size, &trailer, sizeof(trailer));
+        payloadSerial.adopt(std::move(bytes));
+        sealed = true;
+    }
+
+    Key keySerial;
+    Value payloadSerial;
+    std::uint32_t keySize = 0;
+    bool writingPayload = false;
+    bool sealed = false; // the trailer is written
+};
+
+//----------------------------------------------------------------------------//
+
+// The key and the payload of a record, without copying. A record which is
+// too short for its key is not valid and has an empty key and payload.
+class RecordView {
+public:
+    RecordView(const detail::byte* data, std::size_t size) {
+        if (size < detail::RECORD_TRAILER_SIZE) {
+            return;
+        }
+        size -= detail::RECORD_TRAILER_SIZE;
+        std::uint32_t keySize;
+        std::memcpy(&keySize, data + size, sizeof(keySize));
+        keySize = boost::endian::little_to_native(keySize);
+        if (keySize > size) {
+            return;
+        }
+        key = SerialView{data, keySize};
+        payload = SerialView{data + keySize, size - keySize};
+        valid = true;
+    }
+
+    explicit RecordView(const SerialView& record)
+            : RecordView(record.data(), record.size()) {
+    }
+
+    bool isValid() const {
+        return valid;
+    }
+
+    const SerialView& getKey() const {
+        return key;
+    }
+
+    const SerialView& getPayload() const {
+        return payload;
+    }
+
+private:
+    SerialView key;
+    SerialView payload;
+    bool valid = false;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_RECORD_HPP
@@ -0,0 +1,210 @@
+#ifndef SERIALIZATION_REFLECTION_HPP
+#define SERIALIZATION_REFLECTION_HPP
+
+#include "Serial.hpp"
+#include "TypeList.hpp"
+#include "detail/FixedWidth.hpp"
+#include "detail/TypeTraits.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus < 201703L
+#error "Reflection of aggregates needs C++17 (structured bindings)."
+#endif
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+constexpr std::size_t MAX_REFLECTED_FIELD_COUNT = 16;
+
+// Stands in for any field when counting the fields of an aggregate.
+struct AnyField {
+    template <typename T>
+    operator T() const;
+};
+
+template <std::size_t>
+using AnyFieldAt = AnyField;
+
+template <typename T, typename Indices, typename = void>
+struct IsBraceConstructible : std::false_type {
+};
+
+template <typename T, std::size_t... Indices>
+struct IsBraceConstructible<T, std::index_sequence<Indices...>,
+        std::void_t<decltype(T{AnyFieldAt<Indices>{}...})>>
+        : std::true_type {
+};
+
+// The number of fields is the most initializers the aggregate takes.
+template <typename T, std::size_t Count = 0>
+constexpr std::size_t getFieldCount() {
+    if constexpr (Count < MAX_REFLECTED_FIELD_COUNT &&
+            IsBraceConstructible<T,
+                    std::make_index_sequence<Count + 1>>::value) {
+        return getFieldCount<T, Count + 1>();
+    } else {
+        return Count;
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+// References to the fields of an aggregate in declaration order.
+template <typename Aggregate>
+auto tieFields(Aggregate& value) {
+    constexpr std::size_t count =
+            getFieldCount<std::remove_const_t<Aggregate>>();
+    static_assert(count < MAX_REFLECTED_FIELD_COUNT,
+            "Too many fields to reflect!");
+#define SERIALIZATION_TIE_FIELDS(Count, ...)                                   \
+    if constexpr (count == Count) {                                            \
+        auto& [__VA_ARGS__] = value;                                           \
+        return std::tie(__VA_ARGS__);                                          \
+    } else
+
+    if constexpr (count == 0) {
+        return std::tie();
+    } else
+    SERIALIZATION_TIE_FIELDS(1, f0)
+    SERIALIZATION_TIE_FIELDS(2, f0, f1)
+    SERIALIZATION_TIE_FIELDS(3, f0, f1, f2)
+    SERIALIZATION_TIE_FIELDS(4, f0, f1, f2, f3)
+    SERIALIZATION_TIE_FIELDS(5, f0, f1, f2, f3, f4)
+    SERIALIZATION_TIE_FIELDS(6, f0, f1, f2, f3, f4, f5)
+    SERIALIZATION_TIE_FIELDS(7, f0, f1, f2, f3, f4, f5, f6)
+    SERIALIZATION_TIE_FIELDS(8, f0, f1, f2, f3, f4, f5, f6, f7)
+    SERIALIZATION_TIE_FIELDS(9, f0, f1, f2, f3, f4, f5, f6, f7, f8)
+    SERIALIZATION_TIE_FIELDS(10, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9)
+    SERIALIZATION_TIE_FIELDS(11, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10)
+    SERIALIZATION_TIE_FIELDS(12, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10,
+            f11)
+    SERIALIZATION_TIE_FIELDS(13, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10,
+            f11, f12)
+    SERIALIZATION_TIE_FIELDS(14, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10,
+            f11, f12, f13)
+    SERIALIZATION_TIE_FIELDS(15, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10,
+            f11, f12, f13, f14)
+    {
+        return std::tie();
+    }
+#undef SERIALIZATION_TIE_FIELDS
+}
+
+//----------------------------------------------------------------------------//
+
+// Aggregates registered in SerializableData, which have no hooks of their
+// own, are serialized field by field.
+template <typename T, typename SerializableData, typename IntegerFeature>
+struct IsReflectable : std::integral_constant<bool,
+        std::is_aggregate<T>::value && !std::is_polymorphic<T>::value &&
+                !IsPackable<T>::value &&
+                Contains<typename ToTypeList<SerializableData>::type,
+                        T>::value &&
+                !IsSerializable<T, SerializableData, IntegerFeature>::value> {
+};
+
+// The end of the run of fixed width fields starting at Begin.
+template <typename Fields, std::size_t Begin>
+constexpr std::size_t getFixedWidthRunEnd() {
+    if constexpr (Begin < std::tuple_size<Fields>::value) {
+        if constexpr (IsFixedWidth<std::decay_t<
+                std::tuple_element_t<Begin, Fields>>>::value) {
+            return getFixedWidthRunEnd<Fields, Begin + 1>();
+        } else {
+            return Begin;
+        }
+    } else {
+        return Begin;
+    }
+}
+
+template <std::size_t Begin, typename Fields, typename Serial,
+        std::size_t... Indices>
+void packFixedWidthRun(const Fields& fields, Serial& serial,
+        std::index_sequence<Indices...>) {
+    serial.packFixedWidths(std::get<Begin + Indices>(fields)...);
+}
+
+template <std::size_t Begin, typename Fields, typename Serial,
+        std::size_t... Indices>
+void unpackFixedWidthRun(const Fields& fields, Serial& serial,
+        std::index_sequence<Indices...>) {
+    serial.unpackFixedWidths(std::get<Begin + Indices>(fields)...);
+}
+
+// Runs of fixed width fields are written at once, every other field with
+// operator<<.
+template <std::size_t Begin, typename Fields, typename Serial>
+void packFields(const Fields& fields, Serial& serial) {
+    if constexpr (Begin < std::tuple_size<Fields>::value) {
+        constexpr std::size_t end = getFixedWidthRunEnd<Fields, Begin>();
+        if constexpr (end == Begin) {
+            serial << std::get<Begin>(fields);
+            packFields<Begin + 1>(fields, serial);
+        } else {
+            packFixedWidthRun<Begin>(fields, serial,
+                    std::make_index_sequence<end - Begin>{});
+            packFields<end>(fields, serial);
+        }
+    }
+}
+
+template <std::size_t Begin, typename Fields, typename Serial>
+void unpackFields(const Fields& fields, Serial& serial) {
+    if constexpr (Begin < std::tuple_size<Fields>::value) {
+        constexpr std::size_t end = getFixedWidthRunEnd<Fields, Begin>();
+        if constexpr (end == Begin) {
+            serial >> std::get<Begin>(fields);
+            unpackFields<Begin + 1>(fields, serial);
+        } else {
+            unpackFixedWidthRun<Begin>(fields, serial,
+                    std::make_index_sequence<end - Begin>{});
+            unpackFields<end>(fields, serial);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+//============================================================================//
+
+// Aggregates need no hooks: listing one in SerializableData gives its type
+// id, and its fields (at most 15, no base classes) are serialized in
+// declaration order. Serial finds these through argument dependent lookup.
+//
+//     struct Trade {
+//         std::int32_t account;
+//         std::int64_t timestamp;
+//         std::string symbol;
+//     };
+//     Serial<TypeList<Trade>> serial;
+//     serial << Trade{7, 1500000000, "ACME"};
+template <typename Aggregate, typename SerializableData,
+        typename IntegerFeature>
+std::enable_if_t<detail::IsReflectable<Aggregate, SerializableData,
+        IntegerFeature>::value>
+serialize(const Aggregate& value,
+        Serial<SerializableData, IntegerFeature>& serial) {
+    detail::packFields<0>(detail::tieFields(value), serial);
+}
+
+template <typename Aggregate, typename SerializableData,
+        typename IntegerFeature>
+std::enable_if_t<detail::IsReflectable<Aggregate, SerializableData,
+        IntegerFeature>::value>
+deserialize(Aggregate& value,
+        Serial<SerializableData, IntegerFeature>& serial) {
+    detail::unpackFields<0>(detail::tieFields(value), serial);
+}
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_REFLECTION_HPP
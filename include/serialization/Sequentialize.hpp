@@ -1,21 +1,28 @@
 #ifndef SERIALIZATION_SEQUENTIALIZE_HPP
 #define SERIALIZATION_SEQUENTIALIZE_HPP
 
+#include "CaseInsensitiveString.hpp"
+#include "Dictionary.hpp"
 #include "Features.hpp"
+#include "Statistics.hpp"
 #include "detail/ByteSequence.hpp"
+#include "detail/CaseFolding.hpp"
 #include "detail/ConversionMap.hpp"
+#include "detail/FixedWidth.hpp"
+#include "detail/Hash.hpp"
+#include "detail/OrderPreserving.hpp"
 
+#include <boost/assert.hpp>
 // Boost.Endian uses compiler intrinsics if available
 #include <boost/endian/conversion.hpp>
-#include <boost/mpl/at.hpp>
-#include <boost/mpl/has_key.hpp>
-#include <boost/mpl/insert.hpp>
 #include <boost/operators.hpp>
 #include <boost/range/iterator_range_core.hpp>
 
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <string>
+#include <utility>
 
 //============================================================================//
 namespace serialization {
@@ -32,6 +39,53 @@ public:
                     reinterpret_cast<const byte*>(data) + size) {
     }
 
+    const byte* data() const {
+        return byteSequence.data();
+    }
+
+    std::size_t size() const {
+        return byteSequence.size();
+    }
+
+    std::size_t capacity() const {
+        return byteSequence.capacity();
+    }
+
+    void reserve(std::size_t size) {
+        byteSequence.reserve(size);
+    }
+
+    // Drops the content but keeps the allocated memory for the next one.
+    void reset() {
+        byteSequence.clear();
+        readOffset = 0;
+    }
+
+    // Starts reading from the beginning again.
+    void rewind() {
+        readOffset = 0;
+    }
+
+    // Moves the bytes out without copying. The sequence becomes empty.
+    ByteSequence release() {
+        ByteSequence result = std::move(byteSequence);
+        byteSequence.clear();
+        readOffset = 0;
+        return result;
+    }
+
+    // Takes over the bytes (and the capacity) of a sequence without copying.
+    void adopt(ByteSequence&& sequence) {
+        byteSequence = std::move(sequence);
+        readOffset = 0;
+    }
+
+    // Hash of the bytes (see detail::hashBytes), computed on every call. Keys
+    // used for many probes can keep theirs in a HashedKey.
+    std::uint64_t hash() const {
+        return hashBytes(byteSequence.data(), byteSequence.size());
+    }
+
     bool operator==(const PackableByteSequence& rhs) const {
         return byteSequence.size() == rhs.byteSequence.size() &&
                 std::memcmp(byteSequence.data(), rhs.byteSequence.data(),
@@ -39,23 +93,31 @@ public:
     }
 
     bool operator<(const PackableByteSequence& rhs) const {
-        int difference = std::memcmp(byteSequence.data(), rhs.byteSequence.data(),
-                std::min(byteSequence.size(), rhs.byteSequence.size()));
-        if (difference == 0) {
-            return byteSequence.size() < rhs.byteSequence.size();
-        }
-        return difference;
+        return compareBytes(byteSequence.data(), byteSequence.size(),
+                rhs.byteSequence.data(), rhs.byteSequence.size()) < 0;
     }
 
 protected:
-    void appendToSequence(std::string data) {
+    void appendToSequence(const std::string& data) {
         appendToSequence(reinterpret_cast<const byte*>(data.c_str()),
                 data.size() + 1); // \0 byte
     }
 
+    void appendCaseFoldedToSequence(const std::string& data) {
+        SERIALIZATION_RECORD(const GrowthRecorder growth{byteSequence});
+        detail::appendCaseFolded(byteSequence, data);
+        byteSequence.push_back(0);
+    }
+
+    void appendToSequence(const byte* data, std::size_t size) {
+        SERIALIZATION_RECORD(const GrowthRecorder growth{byteSequence});
+        byteSequence.insert(byteSequence.end(), data, data + size);
+    }
+
     template <typename PackedValue>
     void appendToSequence(const PackedValue& packedValue) {
         const byte* valueArray = reinterpret_cast<const byte*>(&packedValue);
+        SERIALIZATION_RECORD(const GrowthRecorder growth{byteSequence});
         byteSequence.insert(byteSequence.end(), valueArray,
                 valueArray + sizeof(packedValue));
     }
@@ -66,24 +128,35 @@ protected:
                         sizeof(PackedValue)));
     }
 
-private:
-    void appendToSequence(const byte* data, std::size_t size) {
-        byteSequence.insert(byteSequence.end(),
-                reinterpret_cast<const byte*>(data),
-                reinterpret_cast<const byte*>(data) + size);
+    const byte* readFromSequence(std::size_t size) {
+        return checkAndGetNextPointer(size);
+    }
+
+    void skipString() {
+        checkAndGetNextPointer();
+    }
+
+    bool isExhausted() const {
+        return readOffset >= byteSequence.size();
     }
 
+    std::size_t getReadOffset() const {
+        return readOffset;
+    }
+
+private:
     byte* getNextPointer() {
-        return std::addressof(byteSequence[readOffset]);
+        return byteSequence.data() + readOffset;
     }
 
     byte* checkAndGetNextPointer() {
         byte* nextPointer = getNextPointer();
-        std::size_t size = std::strlen(reinterpret_cast<const char*>(
-                        nextPointer));
-        BOOST_ASSERT_MSG(size <= byteSequence.size() - readOffset,
-                "Invalid data in sequence.");
-        readOffset += size;
+        const void* terminator = std::memchr(nextPointer, 0,
+                byteSequence.size() - readOffset);
+        BOOST_ASSERT_MSG(terminator != nullptr, "Invalid data in sequence.");
+        SERIALIZATION_RECORD(recordStringScan(
+                static_cast<const byte*>(terminator) - nextPointer + 1));
+        readOffset += static_cast<const byte*>(terminator) - nextPointer + 1;
         return nextPointer;
     }
 
@@ -120,43 +193,6 @@ template <>
 class Sequentializer<StronglyTypedIntegers>
         : public detail::PackableByteSequence {
 private:
-    template <typename UnsignedInt>
-    constexpr UnsignedInt getOffsetZero() const {
-        static_assert(!std::is_signed<UnsignedInt>::value,
-                "This is not an unsigned int!");
-        return std::numeric_limits<UnsignedInt>::max() -
-               std::numeric_limits<
-                       typename std::make_signed<UnsignedInt>::type>::max();
-    }
-
-    template <typename Int, typename PackedValue>
-    constexpr PackedValue getOffset() const {
-        return static_cast<PackedValue>(std::numeric_limits<Int>::max()) +
-               static_cast<PackedValue>(1);
-    }
-
-    template <typename UnsignedInteger, typename Integer>
-    UnsignedInteger addOffset(const Integer& value) {
-        UnsignedInteger packedValue = 0;
-
-        if (value >= 0) {
-            packedValue = static_cast<UnsignedInteger>(value) +
-                    getOffset<Integer, UnsignedInteger>();
-        } else {
-            packedValue = static_cast<UnsignedInteger>(
-                    value + getOffset<Integer, UnsignedInteger>());
-        }
-        return packedValue;
-    }
-
-    template <typename UnsignedInteger, typename Integer>
-    void shiftAndPackInteger(const Integer& value) {
-        UnsignedInteger packedValue = boost::endian::native_to_big(
-                addOffset<UnsignedInteger>(value));
-        // compressAndAppendToSequence(sequence, packedValue);
-        appendToSequence(packedValue);
-    }
-
     template <typename PackedValue, typename Integer>
     std::size_t unpackAndUnshiftInteger(
             const boost::iterator_range<detail::ByteSequence::const_iterator>&
@@ -164,79 +200,117 @@ private:
             Integer& value) {
         PackedValue packedValue = boost::endian::big_to_native(
                 *reinterpret_cast<const PackedValue*>(&*range.begin()));
-
-        if (packedValue >= getOffsetZero<PackedValue>()) {
-            value = static_cast<Integer>(
-                    packedValue - getOffset<Integer, PackedValue>());
-        } else {
-            value = static_cast<Integer>(packedValue) -
-                    getOffset<Integer, PackedValue>();
-        }
-
+        value = detail::decodeInteger<Integer>(packedValue);
         return sizeof(value);
     }
 
 public:
     using PackableByteSequence::PackableByteSequence;
 
-    template <typename Integer>
-    void pack(const Integer& value) {
-        static_assert(boost::mpl::has_key<detail::ConversionMap, Integer>::value,
+    // Every field is prefixed by its type id.
+    constexpr static bool hasTypeTags = true;
+
+    template <typename FixedWidth>
+    void pack(const FixedWidth& value) {
+        static_assert(detail::IsFixedWidth<FixedWidth>::value,
                 "Cannot pack this type!");
-        using PackedValue = typename boost::mpl::at<detail::ConversionMap,
-                Integer>::type;
-        shiftAndPackInteger<PackedValue>(value);
+        appendToSequence(boost::endian::native_to_big(
+                detail::FixedWidthCodec<FixedWidth>::encode(value)));
     }
 
-    // IEEE-754: double floating point representation
-    // sign: 1 bit, exponent: 11 bit, fraction: 52 bit
-    // It seems to be good as it is now.
-    void pack(const double& value) {
-        using PackedValue =
-                typename boost::mpl::at<detail::ConversionMap, double>::type;
-        // trick the first bit :)
-        double copiedValue = value * -1;
-        PackedValue packedValue =
-                *reinterpret_cast<const PackedValue*>(&copiedValue);
-        packedValue = boost::endian::native_to_big(packedValue);
-        appendToSequence(packedValue);
+    // Writes the same bytes as pack() to output, which has room for them,
+    // and returns the end. Usable in constant expressions, see encodeKey().
+    template <typename FixedWidth>
+    constexpr static detail::byte* packFixedWidth(const FixedWidth& value,
+            detail::byte* output) {
+        return detail::storeBigEndian(
+                detail::FixedWidthCodec<FixedWidth>::encode(value), output);
     }
 
     void pack(const std::string& value) {
         appendToSequence(value);
     }
 
-    template <typename Integer>
-    void unpack(Integer& value) {
-        static_assert(boost::mpl::has_key<detail::ConversionMap, Integer>::value,
+    void pack(const CaseInsensitiveString& value) {
+        appendCaseFoldedToSequence(value.str());
+        appendToSequence(value.str());
+    }
+
+    void pack(const DictionaryCode& value) {
+        BOOST_ASSERT_MSG(value.value() <= detail::MAX_ORDERED_VARINT,
+                "Dictionary code is too big.");
+        detail::byte code[detail::MAX_ORDERED_VARINT_SIZE];
+        appendToSequence(code, detail::encodeOrderedVarint(value.value(), code));
+        if (!value.isFound()) {
+            appendToSequence(value.getMissingValue());
+        }
+    }
+
+    template <typename FixedWidth>
+    void unpack(FixedWidth& value) {
+        static_assert(detail::IsFixedWidth<FixedWidth>::value,
                 "Cannot unpack this type!");
-        using PackedValue = typename boost::mpl::at<detail::ConversionMap,
-                Integer>::type;
+        using Codec = detail::FixedWidthCodec<FixedWidth>;
+        value = Codec::decode(boost::endian::big_to_native(
+                readFromSequence<typename Codec::PackedValue>()));
+    }
 
-        PackedValue packedValue = boost::endian::big_to_native(
-                readFromSequence<PackedValue>());
-
-        if (packedValue >= getOffsetZero<PackedValue>()) {
-            value = static_cast<Integer>(packedValue -
-                    getOffset<Integer, PackedValue>());
-        } else {
-            value = static_cast<Integer>(packedValue) -
-                    getOffset<Integer, PackedValue>();
+    // For checked decoding: a packed value which the type cannot have is
+    // skipped, leaving the value unchanged, and gives false.
+    template <typename FixedWidth>
+    typename std::enable_if<detail::IsFixedWidth<FixedWidth>::value,
+            bool>::type
+    unpackChecked(FixedWidth& value) {
+        using Codec = detail::FixedWidthCodec<FixedWidth>;
+        const typename Codec::PackedValue packedValue =
+                boost::endian::big_to_native(
+                        readFromSequence<typename Codec::PackedValue>());
+        if (!Codec::isValid(packedValue)) {
+            return false;
         }
+        value = Codec::decode(packedValue);
+        return true;
     }
 
-    void unpack(double& value) {
-        using PackedValue =
-                typename boost::mpl::at<detail::ConversionMap, double>::type;
+    template <typename Packable>
+    typename std::enable_if<!detail::IsFixedWidth<Packable>::value,
+            bool>::type
+    unpackChecked(Packable& value) {
+        unpack(value);
+        return true;
+    }
 
-        PackedValue packedValue = boost::endian::big_to_native(
-                readFromSequence<PackedValue>());
-        value = (*reinterpret_cast<const double*>(&packedValue)) * -1;
+    template <typename FixedWidth>
+    static const detail::byte* unpackFixedWidth(const detail::byte* input,
+            FixedWidth& value) {
+        using Codec = detail::FixedWidthCodec<FixedWidth>;
+        typename Codec::PackedValue packedValue;
+        std::memcpy(&packedValue, input, sizeof(packedValue));
+        value = Codec::decode(boost::endian::big_to_native(packedValue));
+        return input + sizeof(packedValue);
     }
 
     void unpack(std::string& value) {
         value = readFromSequence<std::string>();
     }
+
+    void unpack(CaseInsensitiveString& value) {
+        skipString();
+        value = readFromSequence<std::string>();
+    }
+
+    void unpack(DictionaryCode& value) {
+        detail::byte code[detail::MAX_ORDERED_VARINT_SIZE];
+        code[0] = readFromSequence<detail::byte>();
+        const std::size_t size = detail::getOrderedVarintSize(code[0]);
+        BOOST_ASSERT_MSG(size != 0, "Invalid data in sequence.");
+        for (std::size_t i = 1; i < size; ++i) {
+            code[i] = readFromSequence<detail::byte>();
+        }
+        const std::uint32_t decodedCode = detail::decodeOrderedVarint(code);
+        value = DictionaryCode{decodedCode, decodedCode % 2 == 1 ?
+                std::string{} : readFromSequence<std::string>()};
+    }
 };
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
@@ -1,23 +1,27 @@
 #ifndef SERIALIZATION_SERIAL_HPP
 #define SERIALIZATION_SERIAL_HPP
 
+#include "DecodeError.hpp"
 #include "Features.hpp"
 #include "Sequentialize.hpp"
+#include "Statistics.hpp"
+#include "TypeList.hpp"
 #include "concept/Serializable.hpp"
 #include "detail/ByteSequence.hpp"
+#include "detail/FixedWidth.hpp"
 #include "detail/Optional.hpp"
+#include "detail/TypeId.hpp"
 #include "detail/TypeTraits.hpp"
+#include "detail/Validation.hpp"
 
 #include <boost/assert.hpp>
 #include <boost/concept/assert.hpp>
-#include <boost/mpl/size.hpp>
 #include <boost/operators.hpp>
 #include <boost/optional.hpp>
 #include <boost/tti/has_member_function.hpp>
 
 #include <cstdint>
 #include <cstring>
-#include <limits>
 #include <type_traits>
 #include <utility>
 
@@ -26,21 +30,30 @@ namespace serialization {
 namespace detail {
 //----------------------------------------------------------------------------//
 
-template <typename T, typename SerializableData>
-constexpr detail::Optional<std::int8_t> getTypeId(
-        const std::size_t customTypeOffset) {
+// Packable types are tagged with their id in ConversionMap, registered types
+// by their position in the registry (a TypeList), see TypeId.hpp.
+template <typename T, typename Registry>
+constexpr detail::Optional<TypeId> getTypeId() {
     constexpr bool isPackable = detail::IsPackable<T>::value;
-    constexpr bool isTypeRegistered = boost::mpl::contains<SerializableData,
-            T>::value;
+    constexpr bool isTypeRegistered = detail::Contains<Registry, T>::value;
     if (isPackable) {
-        return detail::ElementIndex<detail::PackableData, T>::value;
+        return detail::PackableTypeId<T>::value;
     } else if (isTypeRegistered) {
-        return detail::ElementIndex<SerializableData, T>::value +
-                customTypeOffset;
+        return detail::getCustomTypeId(
+                detail::ElementIndex<Registry, T>::value);
     }
     return detail::none;
 }
 
+constexpr std::size_t sumOf() {
+    return 0;
+}
+
+template <typename... Sizes>
+constexpr std::size_t sumOf(std::size_t size, Sizes... sizes) {
+    return size + sumOf(sizes...);
+}
+
 //----------------------------------------------------------------------------//
 } // nemspace detail
 //============================================================================//
@@ -48,21 +61,23 @@ constexpr detail::Optional<std::int8_t> getTypeId(
 
 // In order to compare arbitrary types in serial form, we need to prepend all
 // raw data in a serial with type tags.
-template <typename SerializableData = boost::mpl::vector<>,
+//
+// Decoding trusts the data by default: running out of bytes or a type
+// mismatch is only caught by assertions. Data from untrusted sources shall be
+// validate()d first, which checks the whole structure in one pass and then
+// makes operator>> report type mismatches and values which the type being
+// read cannot have through getDecodeError().
+template <typename SerializableData = TypeList<>,
         typename IntegerFeature = StronglyTypedIntegers>
 class Serial : public Sequentializer<IntegerFeature> {
 private:
-    static_assert(detail::IsMplSequence<SerializableData>::value,
-            "Template argument must be an mpl sequence!");
+    using Registry = typename detail::ToTypeList<SerializableData>::type;
 
-    static_assert(
-            boost::mpl::size<SerializableData>::value +
-                            boost::mpl::size<detail::PackableData>::value <
-                    std::numeric_limits<std::int8_t>::max(),
-            "Too many custom types!");
+    constexpr static std::size_t CUSTOM_TYPE_COUNT =
+            detail::TypeListSize<Registry>::value;
 
-    constexpr static std::int8_t CUSTOM_TYPE_OFFSET =
-            boost::mpl::size<detail::PackableData>::value;
+    static_assert(CUSTOM_TYPE_COUNT <= detail::MAX_CUSTOM_TYPE_COUNT,
+            "Too many custom types!");
 
 public:
     Serial() = default;
@@ -70,13 +85,40 @@ public:
     using Sequentializer<IntegerFeature>::Sequentializer;
 
     Serial(const Serial&) = delete;
-    Serial(Serial&&) = default;
     Serial& operator=(const Serial&) = delete;
+
+#ifndef SERIALIZATION_ENABLE_STATISTICS
+    Serial(Serial&&) = default;
     Serial& operator=(Serial&&) = default;
+#else
+    // The key is counted once, by the Serial holding it when it is dropped.
+    Serial(Serial&& other)
+            : Sequentializer<IntegerFeature>(std::move(other)),
+              decodeError(other.decodeError),
+              checkedDecoding(other.checkedDecoding), written(other.written) {
+        other.written = false;
+    }
+
+    Serial& operator=(Serial&& other) {
+        recordKeySize();
+        Sequentializer<IntegerFeature>::operator=(std::move(other));
+        decodeError = other.decodeError;
+        checkedDecoding = other.checkedDecoding;
+        written = other.written;
+        other.written = false;
+        return *this;
+    }
+
+    ~Serial() {
+        recordKeySize();
+    }
+#endif
 
     template <typename Packable>
     typename std::enable_if<detail::IsPackable<Packable>::value, Serial&>::type
     operator<<(const Packable& value) {
+        SERIALIZATION_RECORD(const PackRecorder<Packable> record{*this});
+        SERIALIZATION_RECORD(written = true);
         packTypeId<Packable>();
         this->pack(value);
         return *this;
@@ -88,6 +130,8 @@ public:
                     IntegerFeature>::value, Serial&>::type
     operator<<(const Serializable& serializable) {
         BOOST_CONCEPT_ASSERT((concept::Serializable<Serializable, Serial>));
+        SERIALIZATION_RECORD(const PackRecorder<Serializable> record{*this});
+        SERIALIZATION_RECORD(written = true);
         packTypeId<Serializable>();
         serializable.serialize(*this);
         return *this;
@@ -109,6 +153,8 @@ public:
                 "Don't know how to serialize T. Provide the free function "
                 "'void serialize(const T&, Serial&)' or the member "
                 "'void T::serialize(Serial&) const'!");
+        SERIALIZATION_RECORD(const PackRecorder<Serializable> record{*this});
+        SERIALIZATION_RECORD(written = true);
         packTypeId<Serializable>();
         serialize(serializable, *this); // TODO: eliminate duplications
         return *this;
@@ -117,8 +163,15 @@ public:
     template <typename Packable>
     typename std::enable_if<detail::IsPackable<Packable>::value, Serial&>::type
     operator>>(Packable& value) {
-        unpackTypeId<Packable>();
-        this->unpack(value);
+        SERIALIZATION_RECORD(const UnpackRecorder<Packable> record{*this});
+        if (!unpackTypeId<Packable>()) {
+            return *this;
+        }
+        if (!checkedDecoding) {
+            this->unpack(value);
+        } else if (!this->unpackChecked(value)) {
+            decodeError = DecodeError::invalidData;
+        }
         return *this;
     }
 
@@ -128,8 +181,10 @@ public:
                     IntegerFeature>::value, Serial&>::type
     operator>>(Serializable& serializable) {
         BOOST_CONCEPT_ASSERT((concept::Serializable<Serializable, Serial>));
-        unpackTypeId<Serializable>();
-        serializable.deserialize(*this);
+        SERIALIZATION_RECORD(const UnpackRecorder<Serializable> record{*this});
+        if (unpackTypeId<Serializable>()) {
+            serializable.deserialize(*this);
+        }
         return *this;
     }
 
@@ -149,32 +204,257 @@ public:
                 "Don't know how to deserialize T. Provide the free function "
                 "'void deserialize(const T&, Serial&)' or the member "
                 "'void T::deserialize(Serial&)'!");
-        unpackTypeId<Serializable>();
-        deserialize(serializable, *this);
+        SERIALIZATION_RECORD(const UnpackRecorder<Serializable> record{*this});
+        if (unpackTypeId<Serializable>()) {
+            deserialize(serializable, *this);
+        }
         return *this;
     }
 
+    // Packs a run of fixed width values (with their type tags) as one write
+    // of a size known at compile time. The bytes are the same as those of
+    // packing the values one by one.
+    template <typename... FixedWidths>
+    Serial& packFixedWidths(const FixedWidths&... values) {
+        static_assert(sizeof...(FixedWidths) > 0, "Nothing to pack!");
+        constexpr std::size_t size =
+                detail::sumOf(getFixedWidthFieldSize<FixedWidths>()...);
+        detail::byte buffer[size];
+        detail::byte* output = buffer;
+        using Expander = int[];
+        (void)Expander{(output = packFixedWidthField(values, output), 0)...};
+        this->appendToSequence(buffer, size);
+        SERIALIZATION_RECORD((void)Expander{
+                (recordFixedWidthField<FixedWidths>(false), 0)...});
+        SERIALIZATION_RECORD(written = true);
+        return *this;
+    }
+
+    // The counterpart of packFixedWidths(). Validated data is read field by
+    // field, so that errors are reported the same way.
+    template <typename... FixedWidths>
+    Serial& unpackFixedWidths(FixedWidths&... values) {
+        static_assert(sizeof...(FixedWidths) > 0, "Nothing to unpack!");
+        using Expander = int[];
+        if (checkedDecoding) {
+            (void)Expander{(*this >> values, 0)...};
+            return *this;
+        }
+        const detail::byte* input = this->readFromSequence(
+                detail::sumOf(getFixedWidthFieldSize<FixedWidths>()...));
+        (void)Expander{(input = unpackFixedWidthField(input, values), 0)...};
+        SERIALIZATION_RECORD((void)Expander{
+                (recordFixedWidthField<FixedWidths>(true), 0)...});
+        return *this;
+    }
+
+    // Checks that every field is complete and has a known type, then switches
+    // to checked decoding. Fields which were not read because of an error are
+    // left unchanged, and the first error is kept.
+    DecodeError validate() {
+        static_assert(Sequentializer<IntegerFeature>::hasTypeTags,
+                "Only tagged data can be validated!");
+        decodeError = detail::validateSequence(this->data(), this->size(),
+                CUSTOM_TYPE_COUNT);
+        checkedDecoding = true;
+        return decodeError;
+    }
+
+    DecodeError getDecodeError() const {
+        return decodeError;
+    }
+
+    void reset() {
+        SERIALIZATION_RECORD(recordKeySize());
+        Sequentializer<IntegerFeature>::reset();
+        resetDecodeState();
+    }
+
+    void rewind() {
+        Sequentializer<IntegerFeature>::rewind();
+        decodeError = DecodeError::none;
+    }
+
+    detail::ByteSequence release() {
+        SERIALIZATION_RECORD(recordKeySize());
+        resetDecodeState();
+        return Sequentializer<IntegerFeature>::release();
+    }
+
+    void adopt(detail::ByteSequence&& sequence) {
+        SERIALIZATION_RECORD(recordKeySize());
+        Sequentializer<IntegerFeature>::adopt(std::move(sequence));
+        resetDecodeState();
+    }
+
 private:
     template <typename T>
     void packTypeId() {
-        constexpr detail::Optional<std::int8_t> typeId =
-                detail::getTypeId<T, SerializableData>(CUSTOM_TYPE_OFFSET);
-        if (typeId) { // no constexpr if
-            this->pack(*typeId);
+        constexpr detail::Optional<detail::TypeId> typeId =
+                detail::getTypeId<T, Registry>();
+        if (typeId && Sequentializer<IntegerFeature>::hasTypeTags) {
+            detail::byte output[detail::MAX_TYPE_ID_SIZE];
+            this->appendToSequence(output,
+                    detail::encodeTypeId(*typeId, output));
         }
     }
 
     template <typename T>
-    void unpackTypeId() {
-        constexpr detail::Optional<std::int8_t> typeId =
-                detail::getTypeId<T, SerializableData>(CUSTOM_TYPE_OFFSET);
+    bool unpackTypeId() {
+        constexpr detail::Optional<detail::TypeId> typeId =
+                detail::getTypeId<T, Registry>();
+        if (!Sequentializer<IntegerFeature>::hasTypeTags) {
+            return true;
+        }
+        if (checkedDecoding) {
+            return checkAndUnpackTypeId(typeId);
+        }
         if (typeId) { // no constexpr if
-            std::int8_t unpackedTypeId = -1;
-            this->unpack(unpackedTypeId);
+            const detail::TypeId unpackedTypeId = readTypeId();
             BOOST_ASSERT_MSG(unpackedTypeId == *typeId,
                     "Type Id does not match with the expected one.");
         }
+        return true;
+    }
+
+    // An invalid tag gives an id which matches no type.
+    detail::TypeId readTypeId() {
+        detail::byte input[detail::MAX_TYPE_ID_SIZE];
+        input[0] = this->template readFromSequence<detail::byte>();
+        const std::size_t size = detail::getEncodedTypeIdSize(input[0]);
+        if (size == 0) {
+            return detail::MAX_TYPE_ID + 1;
+        }
+        if (size > 1) {
+            std::memcpy(input + 1, this->readFromSequence(size - 1),
+                    size - 1);
+        }
+        return detail::decodeTypeId(input);
+    }
+
+    template <typename FixedWidth>
+    constexpr static std::size_t getFixedWidthFieldSize() {
+        static_assert(detail::IsFixedWidth<FixedWidth>::value,
+                "Not a fixed width type!");
+        return (Sequentializer<IntegerFeature>::hasTypeTags ?
+                detail::getTypeIdSize(
+                        *detail::getTypeId<FixedWidth, Registry>()) : 0) +
+                sizeof(typename detail::PackedValueOf<FixedWidth>::type);
+    }
+
+    template <typename FixedWidth>
+    static detail::byte* packFixedWidthField(const FixedWidth& value,
+            detail::byte* output) {
+        if (Sequentializer<IntegerFeature>::hasTypeTags) {
+            output += detail::encodeTypeId(
+                    *detail::getTypeId<FixedWidth, Registry>(), output);
+        }
+        return Sequentializer<IntegerFeature>::packFixedWidth(value, output);
+    }
+
+    template <typename FixedWidth>
+    static const detail::byte* unpackFixedWidthField(
+            const detail::byte* input, FixedWidth& value) {
+        if (Sequentializer<IntegerFeature>::hasTypeTags) {
+            constexpr detail::TypeId typeId =
+                    *detail::getTypeId<FixedWidth, Registry>();
+            constexpr std::size_t typeIdSize = detail::getTypeIdSize(typeId);
+            BOOST_ASSERT_MSG(
+                    detail::getEncodedTypeIdSize(input[0]) == typeIdSize &&
+                            detail::decodeTypeId(input) == typeId,
+                    "Type Id does not match with the expected one.");
+            input += typeIdSize;
+        }
+        return Sequentializer<IntegerFeature>::unpackFixedWidth(input, value);
     }
+
+    // Counts the bytes of a field of type T packed or unpacked while it is
+    // alive. Untagged custom types are not counted.
+    template <typename T, bool unpacking>
+    class FieldRecorder {
+    public:
+        explicit FieldRecorder(const Serial& serial)
+                : serial(serial), start(getPosition()) {
+        }
+
+        ~FieldRecorder() {
+            constexpr detail::Optional<detail::TypeId> typeId =
+                    detail::getTypeId<T, Registry>();
+            if (typeId) {
+                const std::size_t size = getPosition() - start;
+                unpacking ? detail::recordDecoded(*typeId, size) :
+                        detail::recordEncoded(*typeId, size);
+            }
+        }
+
+        FieldRecorder(const FieldRecorder&) = delete;
+        FieldRecorder& operator=(const FieldRecorder&) = delete;
+
+    private:
+        std::size_t getPosition() const {
+            return unpacking ? serial.getReadOffset() : serial.size();
+        }
+
+        const Serial& serial;
+        const std::size_t start;
+    };
+
+    template <typename T>
+    using PackRecorder = FieldRecorder<T, false>;
+
+    template <typename T>
+    using UnpackRecorder = FieldRecorder<T, true>;
+
+    template <typename FixedWidth>
+    static void recordFixedWidthField(bool unpacking) {
+        constexpr detail::TypeId typeId =
+                *detail::getTypeId<FixedWidth, Registry>();
+        constexpr std::size_t size = getFixedWidthFieldSize<FixedWidth>();
+        unpacking ? detail::recordDecoded(typeId, size) :
+                detail::recordEncoded(typeId, size);
+    }
+
+#ifdef SERIALIZATION_ENABLE_STATISTICS
+    // Only keys written through this Serial are counted, not those it just
+    // decodes. Payloads are not keys.
+    void recordKeySize() {
+        if (Sequentializer<IntegerFeature>::hasTypeTags && written) {
+            detail::recordKeySize(this->size());
+        }
+        written = false;
+    }
+#endif
+
+    void resetDecodeState() {
+        decodeError = DecodeError::none;
+        checkedDecoding = false;
+    }
+
+    // The content is validated: once the type tag matches, the field is
+    // known to be complete.
+    bool checkAndUnpackTypeId(
+            const detail::Optional<detail::TypeId>& typeId) {
+        if (decodeError != DecodeError::none) {
+            return false;
+        }
+        if (typeId) {
+            if (this->isExhausted()) {
+                decodeError = DecodeError::truncated;
+                return false;
+            }
+            if (readTypeId() != *typeId) {
+                decodeError = DecodeError::typeMismatch;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    DecodeError decodeError = DecodeError::none;
+    bool checkedDecoding = false;
+#ifdef SERIALIZATION_ENABLE_STATISTICS
+    bool written = false; // since the last reset, release or adopt
+#endif
 };
 
 //----------------------------------------------------------------------------//
@@ -0,0 +1,119 @@
+#ifndef SERIALIZATION_SERIALPOOL_HPP
+#define SERIALIZATION_SERIALPOOL_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+//============================================================================//
+namespace serialization {
+//----------------------------------------------------------------------------//
+
+// Keeps reset Serials with their buffers, so that encoding a key in a loop
+// does not allocate once the pool is warmed up. Not thread-safe: use one pool
+// per thread, e.g. SerialPool::local().
+template <typename Serial>
+class SerialPool {
+public:
+    // Gives the Serial back to the pool when destroyed.
+    class Handle {
+    public:
+        Handle(Handle&& other)
+                : pool(other.pool), serial(std::move(other.serial)) {
+            other.pool = nullptr;
+        }
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        Handle& operator=(Handle&&) = delete;
+
+        ~Handle() {
+            if (pool != nullptr) {
+                pool->giveBack(std::move(serial));
+            }
+        }
+
+        Serial& operator*() {
+            return serial;
+        }
+
+        Serial* operator->() {
+            return &serial;
+        }
+
+        Serial& get() {
+            return serial;
+        }
+
+    private:
+        friend class SerialPool;
+
+        Handle(SerialPool& pool, Serial&& serial)
+                : pool(&pool), serial(std::move(serial)) {
+        }
+
+        SerialPool* pool;
+        Serial serial;
+    };
+
+    // Serials having grown beyond maxCapacity bytes are not kept, so that a
+    // single huge key does not pin its buffer.
+    explicit SerialPool(std::size_t initialCapacity = 64,
+            std::size_t maxSize = 64, std::size_t maxCapacity = 64 * 1024)
+            : initialCapacity(initialCapacity), maxSize(maxSize),
+              maxCapacity(maxCapacity) {
+        pooled.reserve(maxSize);
+    }
+
+    SerialPool(const SerialPool&) = delete;
+    SerialPool& operator=(const SerialPool&) = delete;
+
+    // The pool of the calling thread. Handles from it must be destroyed on the
+    // same thread.
+    static SerialPool& local() {
+        thread_local SerialPool pool;
+        return pool;
+    }
+
+    Handle acquire() {
+        return Handle{*this, take()};
+    }
+
+    // An empty Serial, having at least initialCapacity bytes reserved.
+    Serial take() {
+        if (pooled.empty()) {
+            Serial serial;
+            serial.reserve(initialCapacity);
+            return serial;
+        }
+        Serial serial = std::move(pooled.back());
+        pooled.pop_back();
+        return serial;
+    }
+
+    void giveBack(Serial&& serial) {
+        if (pooled.size() < maxSize && serial.capacity() <= maxCapacity) {
+            serial.reset();
+            if (serial.capacity() < initialCapacity) {
+                serial.reserve(initialCapacity); // e.g. after release()
+            }
+            pooled.push_back(std::move(serial));
+        }
+    }
+
+    std::size_t size() const {
+        return pooled.size();
+    }
+
+private:
+    std::size_t initialCapacity;
+    std::size_t maxSize;
+    std::size_t maxCapacity;
+    std::vector<Serial> pooled;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_SERIALPOOL_HPP
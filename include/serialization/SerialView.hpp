@@ -0,0 +1,77 @@
+#ifndef SERIALIZATION_SERIALVIEW_HPP
+#define SERIALIZATION_SERIALVIEW_HPP
+
+#include "detail/ByteSequence.hpp"
+
+#include <boost/operators.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+//============================================================================//
+namespace serialization {
+//----------------------------------------------------------------------------//
+
+// Non-owning reference to the bytes of a serial, e.g. a key in a page or a
+// network buffer. Compares the same way as a Serial does.
+class SerialView : public boost::totally_ordered<SerialView> {
+public:
+    constexpr SerialView() = default;
+
+    constexpr SerialView(const detail::byte* data, std::size_t size)
+            : bytes(data), length(size) {
+    }
+
+    SerialView(const std::pair<const detail::byte*, std::size_t>& bytes)
+            : SerialView(bytes.first, bytes.second) {
+    }
+
+    // Anything having the bytes of a serial: Serial, StackSerial, ByteSequence.
+    template <typename Bytes, typename = typename std::enable_if<
+            std::is_convertible<decltype(std::declval<const Bytes&>().data()),
+                    const detail::byte*>::value>::type>
+    SerialView(const Bytes& bytes) : SerialView(bytes.data(), bytes.size()) {
+    }
+
+    constexpr const detail::byte* data() const {
+        return bytes;
+    }
+
+    constexpr std::size_t size() const {
+        return length;
+    }
+
+    bool operator==(const SerialView& rhs) const {
+        return length == rhs.length &&
+                (length == 0 || std::memcmp(bytes, rhs.bytes, length) == 0);
+    }
+
+    bool operator<(const SerialView& rhs) const {
+        return detail::compareBytes(bytes, length, rhs.bytes, rhs.length) < 0;
+    }
+
+private:
+    const detail::byte* bytes = nullptr;
+    std::size_t length = 0;
+};
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+// Transparent comparator for ordered containers of Serials, SerialViews or
+// raw bytes, so that they can be searched with any of these without building
+// (and allocating) a Serial first.
+struct SerialLess {
+    using is_transparent = void;
+
+    bool operator()(const SerialView& lhs, const SerialView& rhs) const {
+        return lhs < rhs;
+    }
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_SERIALVIEW_HPP
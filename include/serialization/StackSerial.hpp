@@ -0,0 +1,88 @@
+#ifndef SERIALIZATION_STACKSERIAL_HPP
+#define SERIALIZATION_STACKSERIAL_HPP
+
+#include "detail/ByteSequence.hpp"
+#include "detail/ConversionMap.hpp"
+#include "detail/FixedWidth.hpp"
+#include "detail/TypeId.hpp"
+#include "detail/TypeTraits.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+//============================================================================//
+namespace serialization {
+//----------------------------------------------------------------------------//
+
+// Builds a key in place, without any allocation, with the same bytes as a
+// Serial would have. Meant for probe keys which only live during a lookup,
+// see SerialLess. Only fixed width types and strings can be packed.
+template <std::size_t Capacity>
+class StackSerial {
+public:
+    template <typename FixedWidth>
+    typename std::enable_if<detail::IsFixedWidth<FixedWidth>::value,
+            StackSerial&>::type
+    operator<<(const FixedWidth& value) {
+        packTypeId<FixedWidth>();
+        pack(value);
+        return *this;
+    }
+
+    StackSerial& operator<<(const std::string& value) {
+        packTypeId<std::string>();
+        append(value.c_str(), value.size() + 1); // \0 byte
+        return *this;
+    }
+
+    StackSerial& operator<<(const char* value) {
+        packTypeId<std::string>();
+        append(value, std::strlen(value) + 1); // \0 byte
+        return *this;
+    }
+
+    const detail::byte* data() const {
+        return bytes.data();
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+
+private:
+    template <typename T>
+    void packTypeId() {
+        detail::byte typeId[detail::MAX_TYPE_ID_SIZE];
+        append(typeId, detail::encodeTypeId(
+                detail::PackableTypeId<T>::value, typeId));
+    }
+
+    template <typename FixedWidth>
+    void pack(const FixedWidth& value) {
+        const auto packedValue = boost::endian::native_to_big(
+                detail::FixedWidthCodec<FixedWidth>::encode(value));
+        append(&packedValue, sizeof(packedValue));
+    }
+
+    void append(const void* data, std::size_t size) {
+        BOOST_ASSERT_MSG(size <= Capacity - length,
+                "Key does not fit into the stack storage.");
+        std::memcpy(bytes.data() + length, data, size);
+        length += size;
+    }
+
+    std::array<detail::byte, Capacity> bytes;
+    std::size_t length = 0;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_STACKSERIAL_HPP
@@ -0,0 +1,254 @@
+#ifndef SERIALIZATION_STATISTICS_HPP
+#define SERIALIZATION_STATISTICS_HPP
+
+#include "detail/ByteSequence.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Statistics are collected only if SERIALIZATION_ENABLE_STATISTICS is defined
+// (the same way in every translation unit). Otherwise the recording
+// statements are not even compiled.
+#ifdef SERIALIZATION_ENABLE_STATISTICS
+#define SERIALIZATION_RECORD(...) __VA_ARGS__
+#else
+#define SERIALIZATION_RECORD(...)
+#endif
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// Type ids from the last slot on are counted together.
+constexpr std::size_t STATISTICS_TYPE_ID_COUNT = 256;
+
+// Size class i holds the sizes in [2^(i - 1), 2^i), class 0 the size 0.
+constexpr std::size_t SIZE_CLASS_COUNT = 65;
+
+inline std::size_t getSizeClass(std::uint64_t size) {
+    std::size_t sizeClass = 0;
+    for (; size != 0; size >>= 1) {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+//============================================================================//
+
+// A snapshot of the counters, see getStatistics(). Bytes of a custom type
+// include those of its fields, which are counted for their own types too.
+struct Statistics {
+    // Indexed by type id.
+    std::array<std::uint64_t, detail::STATISTICS_TYPE_ID_COUNT> encodedBytes{};
+    std::array<std::uint64_t, detail::STATISTICS_TYPE_ID_COUNT> decodedBytes{};
+    // Indexed by size class. Keys are counted when their content is dropped
+    // (reset, release, destruction), empty ones are not.
+    std::array<std::uint64_t, detail::SIZE_CLASS_COUNT> keySizes{};
+    // Indexed by size class, the bytes searched for string terminators.
+    std::array<std::uint64_t, detail::SIZE_CLASS_COUNT> stringScanLengths{};
+    // Reallocations of serials while appending, and the capacity gained.
+    std::uint64_t growthCount = 0;
+    std::uint64_t grownBytes = 0;
+
+    Statistics& operator+=(const Statistics& rhs) {
+        for (std::size_t i = 0; i < encodedBytes.size(); ++i) {
+            encodedBytes[i] += rhs.encodedBytes[i];
+            decodedBytes[i] += rhs.decodedBytes[i];
+        }
+        for (std::size_t i = 0; i < keySizes.size(); ++i) {
+            keySizes[i] += rhs.keySizes[i];
+            stringScanLengths[i] += rhs.stringScanLengths[i];
+        }
+        growthCount += rhs.growthCount;
+        grownBytes += rhs.grownBytes;
+        return *this;
+    }
+};
+
+//============================================================================//
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// The counters of a thread. Only the owner thread writes them, so an update
+// is a relaxed load and store without any locked instruction. Other threads
+// only read them while merging.
+class ThreadCounters {
+public:
+    using Counter = std::atomic<std::uint64_t>;
+
+    static void add(Counter& counter, std::uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+    }
+
+    void mergeInto(Statistics& statistics) const {
+        for (std::size_t i = 0; i < encodedBytes.size(); ++i) {
+            statistics.encodedBytes[i] += load(encodedBytes[i]);
+            statistics.decodedBytes[i] += load(decodedBytes[i]);
+        }
+        for (std::size_t i = 0; i < keySizes.size(); ++i) {
+            statistics.keySizes[i] += load(keySizes[i]);
+            statistics.stringScanLengths[i] += load(stringScanLengths[i]);
+        }
+        statistics.growthCount += load(growthCount);
+        statistics.grownBytes += load(grownBytes);
+    }
+
+    std::array<Counter, STATISTICS_TYPE_ID_COUNT> encodedBytes{};
+    std::array<Counter, STATISTICS_TYPE_ID_COUNT> decodedBytes{};
+    std::array<Counter, SIZE_CLASS_COUNT> keySizes{};
+    std::array<Counter, SIZE_CLASS_COUNT> stringScanLengths{};
+    Counter growthCount{0};
+    Counter grownBytes{0};
+
+private:
+    static std::uint64_t load(const Counter& counter) {
+        return counter.load(std::memory_order_relaxed);
+    }
+};
+
+// Knows the counters of the running threads and keeps those of the finished
+// ones. Never destroyed, so that threads may finish after static
+// destruction.
+class StatisticsRegistry {
+public:
+    static StatisticsRegistry& getInstance() {
+        static StatisticsRegistry* registry = new StatisticsRegistry;
+        return *registry;
+    }
+
+    void add(const ThreadCounters* counters) {
+        std::lock_guard<std::mutex> lock{mutex};
+        threads.push_back(counters);
+    }
+
+    void remove(const ThreadCounters* counters) {
+        std::lock_guard<std::mutex> lock{mutex};
+        counters->mergeInto(finishedThreads);
+        for (std::size_t i = 0; i < threads.size(); ++i) {
+            if (threads[i] == counters) {
+                threads[i] = threads.back();
+                threads.pop_back();
+                break;
+            }
+        }
+    }
+
+    Statistics merge() {
+        std::lock_guard<std::mutex> lock{mutex};
+        Statistics statistics = finishedThreads;
+        for (const ThreadCounters* counters : threads) {
+            counters->mergeInto(statistics);
+        }
+        return statistics;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<const ThreadCounters*> threads;
+    Statistics finishedThreads;
+};
+
+class RegisteredThreadCounters {
+public:
+    RegisteredThreadCounters() {
+        StatisticsRegistry::getInstance().add(&counters);
+    }
+
+    ~RegisteredThreadCounters() {
+        StatisticsRegistry::getInstance().remove(&counters);
+    }
+
+    RegisteredThreadCounters(const RegisteredThreadCounters&) = delete;
+    RegisteredThreadCounters& operator=(
+            const RegisteredThreadCounters&) = delete;
+
+    ThreadCounters counters;
+};
+
+inline ThreadCounters& getThreadCounters() {
+    thread_local RegisteredThreadCounters registered;
+    return registered.counters;
+}
+
+//----------------------------------------------------------------------------//
+
+inline void recordEncoded(std::size_t typeId, std::size_t size) {
+    ThreadCounters::add(getThreadCounters().encodedBytes[
+            typeId < STATISTICS_TYPE_ID_COUNT ? typeId :
+                    STATISTICS_TYPE_ID_COUNT - 1], size);
+}
+
+inline void recordDecoded(std::size_t typeId, std::size_t size) {
+    ThreadCounters::add(getThreadCounters().decodedBytes[
+            typeId < STATISTICS_TYPE_ID_COUNT ? typeId :
+                    STATISTICS_TYPE_ID_COUNT - 1], size);
+}
+
+inline void recordKeySize(std::size_t size) {
+    if (size != 0) {
+        ThreadCounters::add(getThreadCounters().keySizes[
+                getSizeClass(size)], 1);
+    }
+}
+
+inline void recordStringScan(std::size_t length) {
+    ThreadCounters::add(getThreadCounters().stringScanLengths[
+            getSizeClass(length)], 1);
+}
+
+// Records a reallocation of the sequence between its construction and
+// destruction.
+class GrowthRecorder {
+public:
+    explicit GrowthRecorder(const ByteSequence& sequence)
+            : sequence(sequence), capacity(sequence.capacity()) {
+    }
+
+    ~GrowthRecorder() {
+        if (sequence.capacity() > capacity) {
+            ThreadCounters& counters = getThreadCounters();
+            ThreadCounters::add(counters.growthCount, 1);
+            ThreadCounters::add(counters.grownBytes,
+                    sequence.capacity() - capacity);
+        }
+    }
+
+    GrowthRecorder(const GrowthRecorder&) = delete;
+    GrowthRecorder& operator=(const GrowthRecorder&) = delete;
+
+private:
+    const ByteSequence& sequence;
+    const std::size_t capacity;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+//============================================================================//
+
+#ifdef SERIALIZATION_ENABLE_STATISTICS
+constexpr bool STATISTICS_ENABLED = true;
+#else
+constexpr bool STATISTICS_ENABLED = false;
+#endif
+
+// Merges the counters of every thread. Counters only grow: the statistics of
+// an interval are the difference of two snapshots. Without
+// SERIALIZATION_ENABLE_STATISTICS everything is 0.
+inline Statistics getStatistics() {
+    return STATISTICS_ENABLED ? detail::StatisticsRegistry::getInstance()
+            .merge() : Statistics{};
+}
+
+//----------------------------------------------------------------------------//
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_STATISTICS_HPP
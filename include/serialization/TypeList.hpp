@@ -0,0 +1,141 @@
+#ifndef SERIALIZATION_TYPELIST_HPP
+#define SERIALIZATION_TYPELIST_HPP
+
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/is_sequence.hpp>
+#include <boost/mpl/next.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+//============================================================================//
+namespace serialization {
+//----------------------------------------------------------------------------//
+
+// The registry of custom types: the position of a type is its type id (after
+// the packable types). Boost.MPL sequences are accepted as well.
+template <typename... Types>
+struct TypeList {
+};
+
+//============================================================================//
+namespace detail {
+//----------------------------------------------------------------------------//
+
+template <std::size_t Index, typename T>
+struct IndexedType {
+};
+
+// Derives from every element paired with its position, once per list, so that
+// a lookup is a single overload resolution instead of a walk through the list.
+template <typename Indices, typename... Types>
+struct IndexedTypes;
+
+template <std::size_t... Indices, typename... Types>
+struct IndexedTypes<std::index_sequence<Indices...>, Types...>
+        : IndexedType<Indices, Types>... {
+};
+
+template <typename T, std::size_t Index>
+std::integral_constant<std::size_t, Index> findElementIndex(
+        const IndexedType<Index, T>*);
+
+// Not contained (or contained more than once).
+template <typename T>
+std::integral_constant<std::size_t, ~std::size_t{0}> findElementIndex(
+        const void*);
+
+//----------------------------------------------------------------------------//
+
+template <typename List>
+struct TypeListSize;
+
+template <typename... Types>
+struct TypeListSize<TypeList<Types...>>
+        : std::integral_constant<std::size_t, sizeof...(Types)> {
+};
+
+// The position of Element, or the size of the list if it is not contained.
+template <typename List, typename Element>
+struct ElementIndex;
+
+template <typename... Types, typename Element>
+struct ElementIndex<TypeList<Types...>, Element> {
+private:
+    constexpr static std::size_t found = decltype(findElementIndex<Element>(
+            std::declval<const IndexedTypes<
+                    std::index_sequence_for<Types...>, Types...>*>()))::value;
+
+public:
+    constexpr static std::size_t value =
+            found < sizeof...(Types) ? found : sizeof...(Types);
+};
+
+template <typename List, typename Element>
+struct Contains : std::integral_constant<bool,
+        ElementIndex<List, Element>::value < TypeListSize<List>::value> {
+};
+
+template <typename... Lists>
+struct ConcatTypeLists {
+    using type = TypeList<>;
+};
+
+template <typename... Types>
+struct ConcatTypeLists<TypeList<Types...>> {
+    using type = TypeList<Types...>;
+};
+
+template <typename... First, typename... Second, typename... Lists>
+struct ConcatTypeLists<TypeList<First...>, TypeList<Second...>, Lists...>
+        : ConcatTypeLists<TypeList<First..., Second...>, Lists...> {
+};
+
+//----------------------------------------------------------------------------//
+
+template <typename List, typename First, typename Last>
+struct AppendMplElements {
+    using type = List;
+};
+
+template <typename... Registered, typename First, typename Last>
+struct AppendMplElements<TypeList<Registered...>, First, Last>
+        : AppendMplElements<TypeList<Registered...,
+                        typename boost::mpl::deref<First>::type>,
+                typename boost::mpl::next<First>::type, Last> {
+};
+
+template <typename... Registered, typename Last>
+struct AppendMplElements<TypeList<Registered...>, Last, Last> {
+    using type = TypeList<Registered...>;
+};
+
+// Converts a registry given as an mpl sequence (e.g. an mpl::vector) into a
+// TypeList.
+template <typename Sequence, typename = void>
+struct ToTypeList {
+    static_assert(sizeof(Sequence*) == 0,
+            "Template argument must be a TypeList or an mpl sequence!");
+};
+
+template <typename Sequence>
+struct ToTypeList<Sequence, typename std::enable_if<
+        boost::mpl::is_sequence<Sequence>::value>::type>
+        : AppendMplElements<TypeList<>,
+                typename boost::mpl::begin<Sequence>::type,
+                typename boost::mpl::end<Sequence>::type> {
+};
+
+template <typename... Types>
+struct ToTypeList<TypeList<Types...>> {
+    using type = TypeList<Types...>;
+};
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_TYPELIST_HPP
@@ -1,6 +1,10 @@
 #ifndef SERIALIZATION_BYTESEQUENCE_HPP
 #define SERIALIZATION_BYTESEQUENCE_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 
 //============================================================================//
@@ -14,6 +18,44 @@ using byte = unsigned char;
 // space is needed (dequeue is not good here).
 using ByteSequence = std::vector<byte>;
 
+//----------------------------------------------------------------------------//
+
+// Lexicographical comparison of raw bytes, a shorter prefix comes first.
+inline int compareBytes(const byte* lhs, std::size_t lhsSize, const byte* rhs,
+        std::size_t rhsSize) {
+    const std::size_t commonSize = std::min(lhsSize, rhsSize);
+    const int difference = commonSize == 0 ? 0 :
+            std::memcmp(lhs, rhs, commonSize);
+    if (difference != 0) {
+        return difference;
+    }
+    return lhsSize < rhsSize ? -1 : lhsSize > rhsSize ? 1 : 0;
+}
+
+// The number of leading bytes which are the same, compared 8 at a time.
+inline std::size_t getCommonPrefixSize(const byte* lhs, std::size_t lhsSize,
+        const byte* rhs, std::size_t rhsSize) {
+    const std::size_t size = std::min(lhsSize, rhsSize);
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        std::uint64_t lhsWord;
+        std::uint64_t rhsWord;
+        std::memcpy(&lhsWord, lhs + i, sizeof(lhsWord));
+        std::memcpy(&rhsWord, rhs + i, sizeof(rhsWord));
+        if (lhsWord != rhsWord) {
+#if defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            return i + (__builtin_ctzll(lhsWord ^ rhsWord) >> 3);
+#else
+            break;
+#endif
+        }
+    }
+    while (i < size && lhs[i] == rhs[i]) {
+        ++i;
+    }
+    return i;
+}
+
 //----------------------------------------------------------------------------//
 } // namespace detail
 } // namespace serialization
@@ -0,0 +1,224 @@
+#ifndef SERIALIZATION_DETAIL_CASEFOLDING_HPP
+#define SERIALIZATION_DETAIL_CASEFOLDING_HPP
+
+#include "ByteSequence.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// Simple case folding (one code point to one code point) of the scripts
+// having case: Latin, Greek, Cyrillic, Armenian and the fullwidth Latin
+// letters. Everything else is left as it is.
+inline char32_t foldCodePoint(char32_t codePoint) {
+    if (codePoint < 0x80) {
+        return codePoint >= 'A' && codePoint <= 'Z' ?
+                codePoint + 0x20 : codePoint;
+    }
+    if (codePoint >= 0xC0 && codePoint <= 0xDE && codePoint != 0xD7) {
+        return codePoint + 0x20;
+    }
+    if (codePoint == 0xB5) { // micro sign
+        return 0x3BC;
+    }
+    if (codePoint >= 0x100 && codePoint <= 0x17F) {
+        if (codePoint == 0x130 || codePoint == 0x138) {
+            return codePoint;
+        }
+        if (codePoint == 0x178) {
+            return 0xFF;
+        }
+        if (codePoint == 0x17F) { // long s
+            return 's';
+        }
+        if ((codePoint >= 0x139 && codePoint <= 0x148) ||
+                (codePoint >= 0x179 && codePoint <= 0x17E)) {
+            return codePoint % 2 == 1 ? codePoint + 1 : codePoint;
+        }
+        return codePoint % 2 == 0 ? codePoint + 1 : codePoint;
+    }
+    if (codePoint >= 0x391 && codePoint <= 0x3AB && codePoint != 0x3A2) {
+        return codePoint + 0x20;
+    }
+    if (codePoint == 0x3C2) { // final sigma
+        return 0x3C3;
+    }
+    if (codePoint >= 0x400 && codePoint <= 0x40F) {
+        return codePoint + 0x50;
+    }
+    if (codePoint >= 0x410 && codePoint <= 0x42F) {
+        return codePoint + 0x20;
+    }
+    if ((codePoint >= 0x460 && codePoint <= 0x481) ||
+            (codePoint >= 0x48A && codePoint <= 0x4BF) ||
+            (codePoint >= 0x4D0 && codePoint <= 0x52F)) {
+        return codePoint % 2 == 0 ? codePoint + 1 : codePoint;
+    }
+    if (codePoint == 0x4C0) {
+        return 0x4CF;
+    }
+    if (codePoint >= 0x4C1 && codePoint <= 0x4CE) {
+        return codePoint % 2 == 1 ? codePoint + 1 : codePoint;
+    }
+    if (codePoint >= 0x531 && codePoint <= 0x556) {
+        return codePoint + 0x30;
+    }
+    if (codePoint >= 0x1E00 && codePoint <= 0x1EFF &&
+            (codePoint < 0x1E96 || codePoint > 0x1E9F)) {
+        return codePoint % 2 == 0 ? codePoint + 1 : codePoint;
+    }
+    if (codePoint >= 0xFF21 && codePoint <= 0xFF3A) {
+        return codePoint + 0x20;
+    }
+    return codePoint;
+}
+
+//----------------------------------------------------------------------------//
+
+// Returns the number of bytes the UTF-8 sequence at data takes, or 0 if it is
+// not a valid sequence.
+inline std::size_t decodeUtf8(const byte* data, std::size_t size,
+        char32_t& codePoint) {
+    const byte lead = data[0];
+    std::size_t length = 0;
+    char32_t minimum = 0;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        minimum = 0x80;
+        codePoint = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        minimum = 0x800;
+        codePoint = lead & 0x0F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        minimum = 0x10000;
+        codePoint = lead & 0x07;
+    } else {
+        return 0;
+    }
+    if (length > size) {
+        return 0;
+    }
+    for (std::size_t i = 1; i < length; ++i) {
+        if ((data[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        codePoint = (codePoint << 6) | (data[i] & 0x3F);
+    }
+    if (codePoint < minimum || codePoint > 0x10FFFF ||
+            (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+        return 0;
+    }
+    return length;
+}
+
+inline void appendUtf8(ByteSequence& sequence, char32_t codePoint) {
+    if (codePoint < 0x80) {
+        sequence.push_back(static_cast<byte>(codePoint));
+        return;
+    }
+    if (codePoint < 0x800) {
+        sequence.push_back(static_cast<byte>(0xC0 | (codePoint >> 6)));
+    } else if (codePoint < 0x10000) {
+        sequence.push_back(static_cast<byte>(0xE0 | (codePoint >> 12)));
+        sequence.push_back(static_cast<byte>(0x80 | ((codePoint >> 6) & 0x3F)));
+    } else {
+        sequence.push_back(static_cast<byte>(0xF0 | (codePoint >> 18)));
+        sequence.push_back(static_cast<byte>(0x80 | ((codePoint >> 12) & 0x3F)));
+        sequence.push_back(static_cast<byte>(0x80 | ((codePoint >> 6) & 0x3F)));
+    }
+    sequence.push_back(static_cast<byte>(0x80 | (codePoint & 0x3F)));
+}
+
+//----------------------------------------------------------------------------//
+
+// Lower cases 8 ASCII characters at once. All bytes must be below 0x80.
+inline std::uint64_t foldAsciiWord(std::uint64_t word) {
+    constexpr std::uint64_t ones = 0x0101010101010101ULL;
+    const std::uint64_t aboveOrA = word + ones * (0x80 - 'A');
+    const std::uint64_t aboveZ = word + ones * (0x80 - 'Z' - 1);
+    const std::uint64_t isUpper = aboveOrA & ~aboveZ & ones * 0x80;
+    return word | (isUpper >> 2);
+}
+
+// Appends the case folded form of a UTF-8 string. Bytes which are not part of
+// a valid UTF-8 sequence are appended unchanged.
+inline void appendCaseFolded(ByteSequence& sequence, const std::string& text) {
+    const byte* data = reinterpret_cast<const byte*>(text.data());
+    const std::size_t size = text.size();
+    std::size_t offset = 0;
+    sequence.reserve(sequence.size() + size);
+
+    while (offset < size) {
+#ifdef __SSE2__
+        while (size - offset >= 16) {
+            __m128i chunk = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(data + offset));
+            if (_mm_movemask_epi8(chunk) != 0) {
+                break;
+            }
+            const __m128i isUpper = _mm_and_si128(
+                    _mm_cmpgt_epi8(chunk, _mm_set1_epi8('A' - 1)),
+                    _mm_cmplt_epi8(chunk, _mm_set1_epi8('Z' + 1)));
+            chunk = _mm_or_si128(chunk,
+                    _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+            const std::size_t end = sequence.size();
+            sequence.resize(end + 16);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&sequence[end]),
+                    chunk);
+            offset += 16;
+        }
+#endif
+        while (size - offset >= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, data + offset, sizeof(word));
+            if ((word & 0x8080808080808080ULL) != 0) {
+                break;
+            }
+            word = foldAsciiWord(word);
+            const std::size_t end = sequence.size();
+            sequence.resize(end + 8);
+            std::memcpy(&sequence[end], &word, sizeof(word));
+            offset += 8;
+        }
+
+        // Slow path up to the next 8 ASCII characters.
+        const std::size_t end = offset + 8 < size ? offset + 8 : size;
+        while (offset < end) {
+            const byte current = data[offset];
+            if (current < 0x80) {
+                sequence.push_back(static_cast<byte>(
+                        foldCodePoint(current)));
+                ++offset;
+                continue;
+            }
+            char32_t codePoint = 0;
+            const std::size_t length = decodeUtf8(data + offset,
+                    size - offset, codePoint);
+            if (length == 0) {
+                sequence.push_back(current);
+                ++offset;
+                continue;
+            }
+            appendUtf8(sequence, foldCodePoint(codePoint));
+            offset += length;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_DETAIL_CASEFOLDING_HPP
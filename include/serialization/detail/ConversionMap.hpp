@@ -1,23 +1,208 @@
 #ifndef SERIALIZATION_DETAIL_CONVERSIONMAP_HPP
 #define SERIALIZATION_DETAIL_CONVERSIONMAP_HPP
 
-#include <boost/mpl/map.hpp>
-#include <boost/mpl/pair.hpp>
+#include "TypeId.hpp"
+#include "../TypeList.hpp"
 
+#include <chrono>
+#include <cstdint>
+#include <ratio>
 #include <string>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SIZEOF_INT128__
+#define SERIALIZATION_HAS_INT128
+#endif
 
 //============================================================================//
 namespace serialization {
+//----------------------------------------------------------------------------//
+
+class CaseInsensitiveString;
+class DictionaryCode;
+
+//============================================================================//
 namespace detail {
 //----------------------------------------------------------------------------//
 
-using ConversionMap = boost::mpl::map<
-        boost::mpl::pair<std::int8_t, std::uint8_t>,
-        boost::mpl::pair<std::int16_t, std::uint16_t>,
-        boost::mpl::pair<std::int32_t, std::uint32_t>,
-        boost::mpl::pair<std::int64_t, std::uint64_t>,
-        boost::mpl::pair<double, std::uint64_t>,
-        boost::mpl::pair<std::string, void>>;
+#ifdef SERIALIZATION_HAS_INT128
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+//----------------------------------------------------------------------------//
+
+// Stand-ins for families of packable types which share a type id and a
+// representation: every Decimal<P, S> having the same storage and scale, and
+// the durations and time points of a clock having the same period (stored as
+// their tick count).
+template <typename Storage, unsigned Scale>
+struct DecimalTag {
+};
+
+template <typename Period>
+struct DurationTag {
+};
+
+template <typename Clock, typename Period>
+struct TimePointTag {
+};
+
+template <typename Period>
+using SystemTimePointTag = TimePointTag<std::chrono::system_clock, Period>;
+
+template <typename Period>
+using SteadyTimePointTag = TimePointTag<std::chrono::steady_clock, Period>;
+
+//----------------------------------------------------------------------------//
+
+template <typename Key, typename PackedValue, TypeId Id>
+struct Conversion {
+};
+
+template <typename Storage, typename PackedValue, TypeId FirstId,
+        typename Scales>
+struct MakeDecimalConversions;
+
+template <typename Storage, typename PackedValue, TypeId FirstId,
+        unsigned... Scales>
+struct MakeDecimalConversions<Storage, PackedValue, FirstId,
+        std::integer_sequence<unsigned, Scales...>> {
+    using type = TypeList<Conversion<DecimalTag<Storage, Scales>, PackedValue,
+            FirstId + Scales>...>;
+};
+
+// Decimals of every scale up to the precision of their storage, with
+// consecutive ids from FirstId on.
+template <typename Storage, typename PackedValue, TypeId FirstId,
+        unsigned MaxScale>
+using DecimalConversions = typename MakeDecimalConversions<Storage,
+        PackedValue, FirstId,
+        std::make_integer_sequence<unsigned, MaxScale + 1>>::type;
+
+template <template <typename> class Tag, TypeId FirstId, typename Periods,
+        typename Indices>
+struct MakePeriodConversions;
+
+template <template <typename> class Tag, TypeId FirstId, typename... Periods,
+        std::size_t... Indices>
+struct MakePeriodConversions<Tag, FirstId, TypeList<Periods...>,
+        std::index_sequence<Indices...>> {
+    using type = TypeList<Conversion<Tag<Periods>, std::uint64_t,
+            FirstId + Indices>...>;
+};
+
+// The periods of the standard durations, from nanoseconds to weeks. Each has
+// its own type id, so a key is never read in another unit.
+using PackablePeriods = TypeList<std::nano, std::micro, std::milli,
+        std::ratio<1>, std::ratio<60>, std::ratio<3600>, std::ratio<86400>,
+        std::ratio<604800>>;
+
+template <template <typename> class Tag, TypeId FirstId>
+using PeriodConversions = typename MakePeriodConversions<Tag, FirstId,
+        PackablePeriods,
+        std::make_index_sequence<TypeListSize<PackablePeriods>::value>>::type;
+
+// Each packable type is mapped to the narrowest unsigned integer which can hold
+// its order preserving form, and to its type id. The ids are fixed, new types
+// take the next free id of the packable range (see TypeId.hpp).
+using ConversionMap = ConcatTypeLists<
+        TypeList<
+                Conversion<std::int8_t, std::uint8_t, 0>,
+                Conversion<std::int16_t, std::uint16_t, 1>,
+                Conversion<std::int32_t, std::uint32_t, 2>,
+                Conversion<std::int64_t, std::uint64_t, 3>,
+                Conversion<double, std::uint64_t, 4>,
+                Conversion<std::string, void, 5>,
+                Conversion<std::uint8_t, std::uint8_t, 127>,
+                Conversion<std::uint16_t, std::uint16_t, 128>,
+                Conversion<std::uint32_t, std::uint32_t, 129>,
+                Conversion<std::uint64_t, std::uint64_t, 130>,
+                Conversion<bool, std::uint8_t, 131>,
+                Conversion<char, std::uint8_t, 132>,
+                Conversion<float, std::uint32_t, 133>,
+#ifdef SERIALIZATION_HAS_INT128
+                Conversion<int128_t, uint128_t, 134>,
+                Conversion<uint128_t, uint128_t, 135>,
+#endif
+                Conversion<CaseInsensitiveString, void, 136>,
+                Conversion<DictionaryCode, void, 137>>,
+        // The scales of a storage go up to its precision, see Decimal.hpp.
+        DecimalConversions<std::int8_t, std::uint8_t, 138, 2>,
+        DecimalConversions<std::int16_t, std::uint16_t, 141, 4>,
+        DecimalConversions<std::int32_t, std::uint32_t, 146, 9>,
+        DecimalConversions<std::int64_t, std::uint64_t, 156, 18>
+#ifdef SERIALIZATION_HAS_INT128
+        , DecimalConversions<int128_t, uint128_t, 175, 38>
+#endif
+        , PeriodConversions<DurationTag, 214>,
+        PeriodConversions<SystemTimePointTag, 222>,
+        PeriodConversions<SteadyTimePointTag, 230>
+        >::type;
+
+template <typename... Keys, typename... PackedValues, TypeId... Ids>
+constexpr bool hasValidTypeIds(
+        TypeList<Conversion<Keys, PackedValues, Ids>...>) {
+    const TypeId typeIds[] = {Ids...};
+    for (std::size_t i = 0; i < sizeof...(Ids); ++i) {
+        if (typeIds[i] >= FIRST_LONG_CUSTOM_TYPE_ID ||
+                getCustomTypeIndex(typeIds[i]) != MAX_CUSTOM_TYPE_COUNT) {
+            return false;
+        }
+        for (std::size_t j = 0; j < i; ++j) {
+            if (typeIds[j] == typeIds[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(hasValidTypeIds(ConversionMap{}),
+        "Packable types shall have distinct ids from the packable range!");
+
+//----------------------------------------------------------------------------//
+
+template <typename Map>
+struct ConversionKeys;
+
+template <typename... Keys, typename... PackedValues, TypeId... Ids>
+struct ConversionKeys<TypeList<Conversion<Keys, PackedValues, Ids>...>> {
+    using type = TypeList<Keys...>;
+};
+
+// Derives from every conversion, so that overload resolution finds the one of
+// a key without walking through the list.
+template <typename Map>
+struct ConversionLookup;
+
+template <typename... Conversions>
+struct ConversionLookup<TypeList<Conversions...>> : Conversions... {
+};
+
+template <typename Key, typename PackedValue, TypeId Id>
+PackedValue* findPackedValue(const Conversion<Key, PackedValue, Id>*);
+
+template <typename Key, typename PackedValue, TypeId Id>
+std::integral_constant<TypeId, Id> findTypeId(
+        const Conversion<Key, PackedValue, Id>*);
+
+template <typename Key>
+std::integral_constant<TypeId, MAX_TYPE_ID + 1> findTypeId(const void*);
+
+// The packed value of a key of ConversionMap (void for variable width types).
+template <typename Key>
+struct ConvertedValue {
+    using type = typename std::remove_pointer<decltype(findPackedValue<Key>(
+            std::declval<const ConversionLookup<ConversionMap>*>()))>::type;
+};
+
+// The type id of a key of ConversionMap, MAX_TYPE_ID + 1 for other types.
+template <typename Key>
+struct ConvertedTypeId : decltype(findTypeId<Key>(
+        std::declval<const ConversionLookup<ConversionMap>*>())) {
+};
 
 //----------------------------------------------------------------------------//
 } // namespace detail
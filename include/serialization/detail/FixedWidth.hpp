@@ -0,0 +1,189 @@
+#ifndef SERIALIZATION_DETAIL_FIXEDWIDTH_HPP
+#define SERIALIZATION_DETAIL_FIXEDWIDTH_HPP
+
+#include "ConversionMap.hpp"
+#include "OrderPreserving.hpp"
+#include "TypeTraits.hpp"
+#include "../Decimal.hpp"
+
+#include <boost/assert.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+template <typename T>
+struct PackedValueOf {
+    using type = typename ConvertedValue<typename PackableKey<T>::type>::type;
+};
+
+// Packable types which are always packed to the same number of bytes.
+template <typename T, typename = void>
+struct IsFixedWidth : std::false_type {
+};
+
+template <typename T>
+struct IsFixedWidth<T, typename std::enable_if<IsPackable<T>::value>::type>
+        : std::integral_constant<bool,
+                !std::is_void<typename PackedValueOf<T>::type>::value> {
+};
+
+//----------------------------------------------------------------------------//
+
+// Converts a fixed width type to the order preserving unsigned integer it is
+// packed to (in native byte order) and back. Encoding works in constant
+// expressions, except for floating point numbers. isValid() tells whether a
+// packed value of untrusted data can be decoded.
+template <typename T>
+struct FixedWidthCodec {
+    using PackedValue = typename PackedValueOf<T>::type;
+
+    constexpr static PackedValue encode(const T& value) {
+        return encodeInteger<PackedValue>(value);
+    }
+
+    constexpr static bool isValid(const PackedValue&) {
+        return true;
+    }
+
+    constexpr static T decode(const PackedValue& packedValue) {
+        return decodeInteger<T>(packedValue);
+    }
+};
+
+// IEEE-754: single and double floating point representation
+// sign: 1 bit, exponent: 8/11 bit, fraction: 23/52 bit
+template <typename FloatingPoint>
+struct FloatingPointCodec {
+    using PackedValue = typename PackedValueOf<FloatingPoint>::type;
+
+    static PackedValue encode(const FloatingPoint& value) {
+        return encodeFloatingPoint<PackedValue>(value);
+    }
+
+    constexpr static bool isValid(const PackedValue&) {
+        return true;
+    }
+
+    static FloatingPoint decode(const PackedValue& packedValue) {
+        return decodeFloatingPoint<FloatingPoint>(packedValue);
+    }
+};
+
+template <>
+struct FixedWidthCodec<float> : FloatingPointCodec<float> {
+};
+
+template <>
+struct FixedWidthCodec<double> : FloatingPointCodec<double> {
+};
+
+// Other bytes than 0 and 1 would not compare like the values do.
+template <>
+struct FixedWidthCodec<bool> {
+    using PackedValue = typename PackedValueOf<bool>::type;
+
+    constexpr static PackedValue encode(const bool& value) {
+        return static_cast<PackedValue>(value);
+    }
+
+    constexpr static bool isValid(const PackedValue& packedValue) {
+        return packedValue <= 1;
+    }
+
+    constexpr static bool decode(const PackedValue& packedValue) {
+        BOOST_ASSERT_MSG(isValid(packedValue), "Invalid bool in sequence.");
+        return packedValue != 0;
+    }
+};
+
+template <unsigned Precision, unsigned Scale>
+struct FixedWidthCodec<Decimal<Precision, Scale>> {
+    using Value = Decimal<Precision, Scale>;
+    using PackedValue = typename PackedValueOf<Value>::type;
+
+    constexpr static PackedValue encode(const Value& value) {
+        return encodeInteger<PackedValue>(value.unscaledValue());
+    }
+
+    constexpr static bool isValid(const PackedValue&) {
+        return true;
+    }
+
+    constexpr static Value decode(const PackedValue& packedValue) {
+        return Value{decodeInteger<typename Value::Storage>(packedValue)};
+    }
+};
+
+// Durations are stored as their tick count in an std::int64_t. The period is
+// part of the type id, so that no unit conversion can lose precision or
+// overflow.
+template <typename Rep, typename Period>
+struct FixedWidthCodec<std::chrono::duration<Rep, Period>> {
+    static_assert(std::is_integral<Rep>::value,
+            "Only integral durations can be packed!");
+    static_assert(sizeof(Rep) < sizeof(std::int64_t) ||
+            (sizeof(Rep) == sizeof(std::int64_t) && std::is_signed<Rep>::value),
+            "The tick count shall fit into an std::int64_t!");
+
+    using Value = std::chrono::duration<Rep, Period>;
+    using PackedValue = typename PackedValueOf<Value>::type;
+
+    constexpr static PackedValue encode(const Value& value) {
+        return encodeInteger<PackedValue>(
+                static_cast<std::int64_t>(value.count()));
+    }
+
+    // Whether the tick count fits into Rep.
+    constexpr static bool isValid(const PackedValue& packedValue) {
+        return decodeInteger<std::int64_t>(packedValue) >=
+                        static_cast<std::int64_t>(
+                                std::numeric_limits<Rep>::min()) &&
+                decodeInteger<std::int64_t>(packedValue) <=
+                        static_cast<std::int64_t>(
+                                std::numeric_limits<Rep>::max());
+    }
+
+    // Tick counts written with a wider Rep saturate.
+    constexpr static Value decode(const PackedValue& packedValue) {
+        const std::int64_t count = decodeInteger<std::int64_t>(packedValue);
+        return Value{count < static_cast<std::int64_t>(
+                        std::numeric_limits<Rep>::min()) ?
+                std::numeric_limits<Rep>::min() :
+                count > static_cast<std::int64_t>(
+                        std::numeric_limits<Rep>::max()) ?
+                std::numeric_limits<Rep>::max() :
+                static_cast<Rep>(count)};
+    }
+};
+
+template <typename Clock, typename Duration>
+struct FixedWidthCodec<std::chrono::time_point<Clock, Duration>> {
+    using Value = std::chrono::time_point<Clock, Duration>;
+    using PackedValue = typename PackedValueOf<Value>::type;
+
+    constexpr static PackedValue encode(const Value& value) {
+        return FixedWidthCodec<Duration>::encode(value.time_since_epoch());
+    }
+
+    constexpr static bool isValid(const PackedValue& packedValue) {
+        return FixedWidthCodec<Duration>::isValid(packedValue);
+    }
+
+    constexpr static Value decode(const PackedValue& packedValue) {
+        return Value{FixedWidthCodec<Duration>::decode(packedValue)};
+    }
+};
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_DETAIL_FIXEDWIDTH_HPP
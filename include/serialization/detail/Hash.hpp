@@ -0,0 +1,127 @@
+#ifndef SERIALIZATION_DETAIL_HASH_HPP
+#define SERIALIZATION_DETAIL_HASH_HPP
+
+#include "ByteSequence.hpp"
+#include "ConversionMap.hpp"
+
+#include <boost/endian/conversion.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+constexpr std::uint64_t HASH_SECRET_0 = 0x2d358dccaa6c78a5ULL;
+constexpr std::uint64_t HASH_SECRET_1 = 0x8bb84b93962eacc9ULL;
+constexpr std::uint64_t HASH_SECRET_2 = 0x4b33a62ed433d4a3ULL;
+constexpr std::uint64_t HASH_SECRET_3 = 0x4d5a2da51de1aa47ULL;
+
+// 64 x 64 -> 128 bit multiplication, the low half is left in lhs, the high
+// half in rhs.
+inline void multiply(std::uint64_t& lhs, std::uint64_t& rhs) {
+#ifdef SERIALIZATION_HAS_INT128
+    const uint128_t product = static_cast<uint128_t>(lhs) * rhs;
+    lhs = static_cast<std::uint64_t>(product);
+    rhs = static_cast<std::uint64_t>(product >> 64);
+#else
+    const std::uint64_t lhsHigh = lhs >> 32;
+    const std::uint64_t lhsLow = static_cast<std::uint32_t>(lhs);
+    const std::uint64_t rhsHigh = rhs >> 32;
+    const std::uint64_t rhsLow = static_cast<std::uint32_t>(rhs);
+    const std::uint64_t high = lhsHigh * rhsHigh;
+    const std::uint64_t middle0 = lhsHigh * rhsLow;
+    const std::uint64_t middle1 = rhsHigh * lhsLow;
+    const std::uint64_t low = lhsLow * rhsLow;
+    const std::uint64_t carry = ((middle0 & 0xFFFFFFFFULL) +
+            (middle1 & 0xFFFFFFFFULL) + (low >> 32)) >> 32;
+    lhs = low + (middle0 << 32) + (middle1 << 32);
+    rhs = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+}
+
+inline std::uint64_t mix(std::uint64_t lhs, std::uint64_t rhs) {
+    multiply(lhs, rhs);
+    return lhs ^ rhs;
+}
+
+inline std::uint64_t read64(const byte* data) {
+    std::uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return boost::endian::little_to_native(value);
+}
+
+inline std::uint64_t read32(const byte* data) {
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return boost::endian::little_to_native(value);
+}
+
+//----------------------------------------------------------------------------//
+
+inline std::uint64_t mixSeed(std::uint64_t seed) {
+    return seed ^ mix(seed ^ HASH_SECRET_0, HASH_SECRET_1);
+}
+
+// wyhash (final version 4). Equal keys are always encoded to equal bytes, so
+// hashing the bytes is enough. Keys up to 16 bytes, which is most of them,
+// take two multiplications once the seed is mixed.
+inline std::uint64_t hashBytesWithMixedSeed(const byte* data, std::size_t size,
+        std::uint64_t seed) {
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    if (size <= 16) {
+        if (size >= 4) {
+            const std::size_t middle = (size >> 3) << 2;
+            a = (read32(data) << 32) | read32(data + middle);
+            b = (read32(data + size - 4) << 32) |
+                    read32(data + size - 4 - middle);
+        } else if (size > 0) {
+            a = (static_cast<std::uint64_t>(data[0]) << 16) |
+                    (static_cast<std::uint64_t>(data[size >> 1]) << 8) |
+                    data[size - 1];
+        }
+    } else {
+        std::size_t remaining = size;
+        if (remaining >= 48) {
+            std::uint64_t seed1 = seed;
+            std::uint64_t seed2 = seed;
+            do {
+                seed = mix(read64(data) ^ HASH_SECRET_1,
+                        read64(data + 8) ^ seed);
+                seed1 = mix(read64(data + 16) ^ HASH_SECRET_2,
+                        read64(data + 24) ^ seed1);
+                seed2 = mix(read64(data + 32) ^ HASH_SECRET_3,
+                        read64(data + 40) ^ seed2);
+                data += 48;
+                remaining -= 48;
+            } while (remaining >= 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (remaining > 16) {
+            seed = mix(read64(data) ^ HASH_SECRET_1, read64(data + 8) ^ seed);
+            data += 16;
+            remaining -= 16;
+        }
+        a = read64(data + remaining - 16);
+        b = read64(data + remaining - 8);
+    }
+    a ^= HASH_SECRET_1;
+    b ^= seed;
+    multiply(a, b);
+    return mix(a ^ HASH_SECRET_0 ^ size, b ^ HASH_SECRET_1);
+}
+
+inline std::uint64_t hashBytes(const byte* data, std::size_t size,
+        std::uint64_t seed = 0) {
+    return hashBytesWithMixedSeed(data, size, mixSeed(seed));
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_DETAIL_HASH_HPP
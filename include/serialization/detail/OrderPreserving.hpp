@@ -0,0 +1,185 @@
+#ifndef SERIALIZATION_DETAIL_ORDERPRESERVING_HPP
+#define SERIALIZATION_DETAIL_ORDERPRESERVING_HPP
+
+#include "ByteSequence.hpp"
+#include "ConversionMap.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// std::is_signed does not know about __int128 in strict ISO mode.
+// char is deliberately treated as unsigned: single characters are ordered the
+// same way as the bytes of a std::string are (see std::char_traits<char>::lt).
+template <typename T>
+struct IsSignedInteger
+        : std::integral_constant<bool, std::is_signed<T>::value &&
+                  !std::is_same<T, char>::value> {
+};
+
+#ifdef SERIALIZATION_HAS_INT128
+template <>
+struct IsSignedInteger<int128_t> : std::true_type {
+};
+#endif
+
+//----------------------------------------------------------------------------//
+
+template <typename UnsignedInt>
+constexpr UnsignedInt getSignBit() {
+    return static_cast<UnsignedInt>(
+            static_cast<UnsignedInt>(1) << (sizeof(UnsignedInt) * 8 - 1));
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+// Two's complement integers become order preserving unsigned integers by
+// flipping the sign bit. Unsigned integers are already order preserving.
+template <typename PackedValue, typename Integer>
+constexpr PackedValue encodeInteger(const Integer& value) {
+    return static_cast<PackedValue>(static_cast<PackedValue>(value) ^
+            (IsSignedInteger<Integer>::value ? getSignBit<PackedValue>() :
+                    static_cast<PackedValue>(0)));
+}
+
+template <typename Integer, typename PackedValue>
+constexpr Integer decodeInteger(const PackedValue& packedValue) {
+    return static_cast<Integer>(static_cast<PackedValue>(packedValue ^
+            (IsSignedInteger<Integer>::value ? getSignBit<PackedValue>() :
+                    static_cast<PackedValue>(0))));
+}
+
+template <typename UnsignedInt, std::size_t... Indices>
+constexpr byte* storeBigEndian(UnsignedInt value, byte* output,
+        std::index_sequence<Indices...>) {
+    const bool stored[] = {(output[Indices] = static_cast<byte>(value >>
+            (sizeof(UnsignedInt) - 1 - Indices) * 8), true)...};
+    static_cast<void>(stored);
+    return output + sizeof(UnsignedInt);
+}
+
+// Writes the value in big-endian byte order and returns the end. Unlike
+// memcpy and boost::endian it works in constant expressions, and compilers
+// still turn it into a byte swap and a single store.
+template <typename UnsignedInt>
+constexpr byte* storeBigEndian(UnsignedInt value, byte* output) {
+    return storeBigEndian(value, output,
+            std::make_index_sequence<sizeof(UnsignedInt)>{});
+}
+
+#ifdef SERIALIZATION_HAS_INT128
+// Two halves, the shifts of a whole 128 bit value are not merged.
+constexpr byte* storeBigEndian(uint128_t value, byte* output) {
+    return storeBigEndian(static_cast<std::uint64_t>(value),
+            storeBigEndian(static_cast<std::uint64_t>(value >> 64), output));
+}
+#endif
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+// IEEE-754: a positive number gets its sign bit set, a negative number gets
+// all of its bits flipped. That way the bit patterns compare as unsigned
+// integers the same way as the numbers do.
+// -0.0 is normalized to +0.0 and every NaN to the same quiet NaN, so equal
+// values always give equal bytes. NaN sorts after +infinity.
+template <typename PackedValue, typename FloatingPoint>
+PackedValue encodeFloatingPoint(FloatingPoint value) {
+    static_assert(sizeof(PackedValue) == sizeof(FloatingPoint),
+            "Size mismatch!");
+    value = value != value ? std::numeric_limits<FloatingPoint>::quiet_NaN() :
+            value + static_cast<FloatingPoint>(0);
+    PackedValue bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const PackedValue mask = static_cast<PackedValue>(
+            static_cast<PackedValue>(0) - (bits >> (sizeof(bits) * 8 - 1))) |
+            getSignBit<PackedValue>();
+    return bits ^ mask;
+}
+
+template <typename FloatingPoint, typename PackedValue>
+FloatingPoint decodeFloatingPoint(const PackedValue& packedValue) {
+    static_assert(sizeof(PackedValue) == sizeof(FloatingPoint),
+            "Size mismatch!");
+    const PackedValue mask = static_cast<PackedValue>(
+            (packedValue >> (sizeof(packedValue) * 8 - 1)) -
+            static_cast<PackedValue>(1)) | getSignBit<PackedValue>();
+    const PackedValue bits = packedValue ^ mask;
+    FloatingPoint value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+// Order preserving variable length unsigned integers of 1-4 bytes. The leading
+// bits of the first byte tell the length (0, 10, 110, 1110) and each length
+// continues where the previous one ends, so longer means bigger.
+constexpr std::uint32_t MAX_ORDERED_VARINT =
+        0x80 + 0x4000 + 0x200000 + 0x10000000 - 1;
+constexpr std::size_t MAX_ORDERED_VARINT_SIZE = 4;
+
+inline std::size_t encodeOrderedVarint(std::uint32_t value, byte* output) {
+    if (value < 0x80) {
+        output[0] = static_cast<byte>(value);
+        return 1;
+    }
+    value -= 0x80;
+    if (value < 0x4000) {
+        output[0] = static_cast<byte>(0x80 | (value >> 8));
+        output[1] = static_cast<byte>(value);
+        return 2;
+    }
+    value -= 0x4000;
+    if (value < 0x200000) {
+        output[0] = static_cast<byte>(0xC0 | (value >> 16));
+        output[1] = static_cast<byte>(value >> 8);
+        output[2] = static_cast<byte>(value);
+        return 3;
+    }
+    value -= 0x200000;
+    output[0] = static_cast<byte>(0xE0 | (value >> 24));
+    output[1] = static_cast<byte>(value >> 16);
+    output[2] = static_cast<byte>(value >> 8);
+    output[3] = static_cast<byte>(value);
+    return 4;
+}
+
+// Returns 0 if the first byte is invalid.
+inline std::size_t getOrderedVarintSize(byte firstByte) {
+    return firstByte < 0x80 ? 1 : firstByte < 0xC0 ? 2 :
+            firstByte < 0xE0 ? 3 : firstByte < 0xF0 ? 4 : 0;
+}
+
+inline std::uint32_t decodeOrderedVarint(const byte* input) {
+    switch (getOrderedVarintSize(input[0])) {
+    case 1:
+        return input[0];
+    case 2:
+        return 0x80 + ((static_cast<std::uint32_t>(input[0] & 0x3F) << 8) |
+                input[1]);
+    case 3:
+        return 0x80 + 0x4000 +
+                ((static_cast<std::uint32_t>(input[0] & 0x1F) << 16) |
+                (static_cast<std::uint32_t>(input[1]) << 8) | input[2]);
+    default:
+        return 0x80 + 0x4000 + 0x200000 +
+                ((static_cast<std::uint32_t>(input[0] & 0x0F) << 24) |
+                (static_cast<std::uint32_t>(input[1]) << 16) |
+                (static_cast<std::uint32_t>(input[2]) << 8) | input[3]);
+    }
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_DETAIL_ORDERPRESERVING_HPP
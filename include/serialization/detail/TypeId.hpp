@@ -0,0 +1,97 @@
+#ifndef SERIALIZATION_DETAIL_TYPEID_HPP
+#define SERIALIZATION_DETAIL_TYPEID_HPP
+
+#include "ByteSequence.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// Type ids up to 126 are packed as an std::int8_t, into one byte of 0x80 to
+// 0xFE. Bigger ones take the byte 0xFF followed by the id minus 127 as a
+// big-endian std::uint16_t. Both forms keep the order of the ids, and bytes
+// below 0x80 (negative ids) are never valid.
+using TypeId = std::uint32_t;
+
+constexpr TypeId MAX_SHORT_TYPE_ID = 126;
+constexpr TypeId MAX_TYPE_ID = MAX_SHORT_TYPE_ID + 1 + 0xFFFF;
+constexpr byte LONG_TYPE_ID_MARKER = 0xFF;
+constexpr std::size_t MAX_TYPE_ID_SIZE = 3;
+
+// Type ids are stored in keys, so an id never changes once it is assigned.
+// They come from fixed ranges, adding a type of one kind never moves the ids
+// of the other:
+//   0 - 5        the first packable types,
+//   6 - 125      the first 120 registered types in registry order,
+//   126 - 382    further packable types (see ConversionMap),
+//   from 383     the further registered types.
+// The first two ranges are the ids of the one byte format, which allowed up to
+// 120 registered types.
+constexpr TypeId FIRST_CUSTOM_TYPE_ID = 6;
+constexpr std::size_t SHORT_CUSTOM_TYPE_COUNT = 120;
+constexpr TypeId FIRST_LONG_CUSTOM_TYPE_ID = MAX_SHORT_TYPE_ID + 1 + 256;
+constexpr std::size_t MAX_CUSTOM_TYPE_COUNT =
+        SHORT_CUSTOM_TYPE_COUNT + MAX_TYPE_ID + 1 - FIRST_LONG_CUSTOM_TYPE_ID;
+
+// The id of the registered type at the given position of the registry.
+constexpr TypeId getCustomTypeId(std::size_t index) {
+    return static_cast<TypeId>(index < SHORT_CUSTOM_TYPE_COUNT ?
+            FIRST_CUSTOM_TYPE_ID + index :
+            FIRST_LONG_CUSTOM_TYPE_ID + (index - SHORT_CUSTOM_TYPE_COUNT));
+}
+
+// The position of a registered type by its id, or MAX_CUSTOM_TYPE_COUNT if
+// the id is not one of a registered type.
+constexpr std::size_t getCustomTypeIndex(TypeId typeId) {
+    return typeId >= FIRST_CUSTOM_TYPE_ID &&
+                    typeId < FIRST_CUSTOM_TYPE_ID + SHORT_CUSTOM_TYPE_COUNT ?
+            typeId - FIRST_CUSTOM_TYPE_ID :
+            typeId >= FIRST_LONG_CUSTOM_TYPE_ID && typeId <= MAX_TYPE_ID ?
+            SHORT_CUSTOM_TYPE_COUNT + (typeId - FIRST_LONG_CUSTOM_TYPE_ID) :
+            MAX_CUSTOM_TYPE_COUNT;
+}
+
+//----------------------------------------------------------------------------//
+
+constexpr std::size_t getTypeIdSize(TypeId typeId) {
+    return typeId <= MAX_SHORT_TYPE_ID ? 1 : MAX_TYPE_ID_SIZE;
+}
+
+// Returns the number of bytes written.
+constexpr std::size_t encodeTypeId(TypeId typeId, byte* output) {
+    if (typeId <= MAX_SHORT_TYPE_ID) {
+        output[0] = static_cast<byte>(0x80 + typeId);
+        return 1;
+    }
+    const TypeId offset = typeId - MAX_SHORT_TYPE_ID - 1;
+    output[0] = LONG_TYPE_ID_MARKER;
+    output[1] = static_cast<byte>(offset >> 8);
+    output[2] = static_cast<byte>(offset);
+    return MAX_TYPE_ID_SIZE;
+}
+
+// The size of a type id by its first byte, or 0 if it is not valid.
+inline std::size_t getEncodedTypeIdSize(byte first) {
+    return first < 0x80 ? 0 :
+            first == LONG_TYPE_ID_MARKER ? MAX_TYPE_ID_SIZE : 1;
+}
+
+// The input shall hold getEncodedTypeIdSize(input[0]) > 0 bytes.
+inline TypeId decodeTypeId(const byte* input) {
+    if (input[0] != LONG_TYPE_ID_MARKER) {
+        return static_cast<TypeId>(input[0] - 0x80);
+    }
+    return MAX_SHORT_TYPE_ID + 1 +
+            (static_cast<TypeId>(input[1]) << 8 | input[2]);
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_DETAIL_TYPEID_HPP
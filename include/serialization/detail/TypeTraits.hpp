@@ -2,18 +2,12 @@
 #define SERIALIZATION_DETAIL_TYPETRAITS_HPP
 
 #include "ConversionMap.hpp"
+#include "../Decimal.hpp"
+#include "../TypeList.hpp"
 
-#include <boost/mpl/back_inserter.hpp>
-#include <boost/mpl/begin.hpp>
-#include <boost/mpl/contains.hpp>
-#include <boost/mpl/deque.hpp>
-#include <boost/mpl/distance.hpp>
-#include <boost/mpl/equal.hpp>
-#include <boost/mpl/find.hpp>
-#include <boost/mpl/list.hpp>
-#include <boost/mpl/set.hpp>
-#include <boost/mpl/transform.hpp>
-#include <boost/mpl/vector.hpp>
+#include <chrono>
+#include <type_traits>
+#include <utility>
 
 //============================================================================//
 namespace serialization {
@@ -26,9 +20,7 @@ class Serial;
 namespace detail {
 //----------------------------------------------------------------------------//
 
-using PackableData = boost::mpl::transform<ConversionMap,
-        boost::mpl::first<boost::mpl::_1>,
-        boost::mpl::back_inserter<boost::mpl::vector<>>>::type;
+using PackableData = ConversionKeys<ConversionMap>::type;
 
 //----------------------------------------------------------------------------//
 
@@ -77,46 +69,45 @@ struct IsSerializableNonIntrusive<Serializable, TypeSequence, IntegerFeature,
 
 //----------------------------------------------------------------------------//
 
-template<typename T, typename = void>
-struct IsPackable : std::false_type {
+// The key of a packable type in ConversionMap.
+template<typename T>
+struct PackableKey {
+    using type = T;
 };
 
-template<typename Packable>
-struct IsPackable<Packable,
-        typename std::enable_if<boost::mpl::contains<PackableData,
-                               Packable>::value>::type>
-        : std::true_type {
+template<unsigned Precision, unsigned Scale>
+struct PackableKey<Decimal<Precision, Scale>> {
+    using type = DecimalTag<typename Decimal<Precision, Scale>::Storage,
+            Scale>;
 };
 
-//----------------------------------------------------------------------------//
-
-template<typename Sequence, typename Element>
-struct ElementIndex {
-    enum { value =
-           boost::mpl::distance<typename boost::mpl::begin<Sequence>::type,
-                   typename boost::mpl::find<Sequence, Element>::type>::value };
+// Durations of other periods than PackablePeriods are not packable.
+template<typename Rep, typename Period>
+struct PackableKey<std::chrono::duration<Rep, Period>> {
+    using type = DurationTag<typename Period::type>;
 };
 
-//----------------------------------------------------------------------------//
-
-template<typename T>
-struct IsMplSequence : std::false_type {
+template<typename Clock, typename Duration>
+struct PackableKey<std::chrono::time_point<Clock, Duration>> {
+    using type = TimePointTag<Clock, typename Duration::period::type>;
 };
 
-template<typename ...Ts>
-struct IsMplSequence<boost::mpl::vector<Ts...>> : std::true_type {
+template<typename Packable>
+struct PackableTypeId
+        : ConvertedTypeId<typename PackableKey<Packable>::type> {
 };
 
-template<typename ...Ts>
-struct IsMplSequence<boost::mpl::set<Ts...>> : std::true_type {
-};
+//----------------------------------------------------------------------------//
 
-template<typename ...Ts>
-struct IsMplSequence<boost::mpl::list<Ts...>> : std::true_type {
+template<typename T, typename = void>
+struct IsPackable : std::false_type {
 };
 
-template<typename ...Ts>
-struct IsMplSequence<boost::mpl::deque<Ts...>> : std::true_type {
+template<typename Packable>
+struct IsPackable<Packable,
+        typename std::enable_if<Contains<PackableData,
+                typename PackableKey<Packable>::type>::value>::type>
+        : std::true_type {
 };
 
 //----------------------------------------------------------------------------//
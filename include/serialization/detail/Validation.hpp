@@ -0,0 +1,194 @@
+#ifndef SERIALIZATION_DETAIL_VALIDATION_HPP
+#define SERIALIZATION_DETAIL_VALIDATION_HPP
+
+#include "ByteSequence.hpp"
+#include "ConversionMap.hpp"
+#include "OrderPreserving.hpp"
+#include "TypeId.hpp"
+#include "TypeTraits.hpp"
+#include "../DecodeError.hpp"
+#include "../TypeList.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+//============================================================================//
+namespace serialization {
+namespace detail {
+//----------------------------------------------------------------------------//
+
+// How the bytes following the type tag of a packable type are laid out.
+enum class FieldKind : std::uint8_t {
+    unknown, // not a packable type
+    fixed,
+    string,
+    caseInsensitiveString,
+    dictionaryCode
+};
+
+struct FieldLayout {
+    FieldKind kind;
+    std::uint8_t size; // only for fixed
+};
+
+//----------------------------------------------------------------------------//
+
+template <typename PackableKey>
+struct GetFieldLayout {
+    constexpr static FieldLayout get() {
+        return FieldLayout{FieldKind::fixed, static_cast<std::uint8_t>(
+                sizeof(typename ConvertedValue<PackableKey>::type))};
+    }
+};
+
+template <>
+struct GetFieldLayout<std::string> {
+    constexpr static FieldLayout get() {
+        return FieldLayout{FieldKind::string, 0};
+    }
+};
+
+template <>
+struct GetFieldLayout<CaseInsensitiveString> {
+    constexpr static FieldLayout get() {
+        return FieldLayout{FieldKind::caseInsensitiveString, 0};
+    }
+};
+
+template <>
+struct GetFieldLayout<DictionaryCode> {
+    constexpr static FieldLayout get() {
+        return FieldLayout{FieldKind::dictionaryCode, 0};
+    }
+};
+
+//----------------------------------------------------------------------------//
+
+// Every type id below this is either packable or registered.
+constexpr TypeId PACKABLE_TYPE_ID_LIMIT = FIRST_LONG_CUSTOM_TYPE_ID;
+
+// Indexed by type id.
+struct FieldLayouts {
+    FieldLayout byTypeId[PACKABLE_TYPE_ID_LIMIT];
+};
+
+template <typename... PackableKeys, typename... PackedValues,
+        TypeId... TypeIds>
+constexpr FieldLayouts makeFieldLayouts(
+        TypeList<Conversion<PackableKeys, PackedValues, TypeIds>...>) {
+    FieldLayouts layouts{};
+    const FieldLayout keyLayouts[] = {GetFieldLayout<PackableKeys>::get()...};
+    const TypeId typeIds[] = {TypeIds...};
+    for (std::size_t i = 0; i < sizeof...(TypeIds); ++i) {
+        layouts.byTypeId[typeIds[i]] = keyLayouts[i];
+    }
+    return layouts;
+}
+
+inline const FieldLayouts& getFieldLayouts() {
+    static constexpr FieldLayouts layouts = makeFieldLayouts(ConversionMap{});
+    return layouts;
+}
+
+//----------------------------------------------------------------------------//
+
+// Returns the size of the string including its terminator, or 0 if it is not
+// terminated.
+inline std::size_t getTerminatedSize(const byte* data, std::size_t size) {
+    const void* terminator = std::memchr(data, 0, size);
+    return terminator == nullptr ? 0 :
+            static_cast<const byte*>(terminator) - data + 1;
+}
+
+// Walks through every field of a serial once. Type ids of custom types are
+// only followed by the tagged fields of the type.
+inline DecodeError validateSequence(const byte* data, std::size_t size,
+        std::size_t customTypeCount) {
+    const FieldLayouts& layouts = getFieldLayouts();
+    std::size_t offset = 0;
+    while (offset < size) {
+        const std::size_t typeIdSize = getEncodedTypeIdSize(data[offset]);
+        if (typeIdSize == 0) {
+            return DecodeError::unknownTypeId;
+        }
+        if (typeIdSize > size - offset) {
+            return DecodeError::truncated;
+        }
+        const TypeId typeId = decodeTypeId(data + offset);
+        offset += typeIdSize;
+        const std::size_t customTypeIndex = getCustomTypeIndex(typeId);
+        if (customTypeIndex != MAX_CUSTOM_TYPE_COUNT) {
+            if (customTypeIndex >= customTypeCount) {
+                return DecodeError::unknownTypeId;
+            }
+            continue;
+        }
+        if (typeId >= PACKABLE_TYPE_ID_LIMIT) {
+            return DecodeError::unknownTypeId;
+        }
+
+        const FieldLayout& layout = layouts.byTypeId[typeId];
+        const std::size_t remaining = size - offset;
+        std::size_t fieldSize = 0;
+        switch (layout.kind) {
+        case FieldKind::unknown:
+            return DecodeError::unknownTypeId;
+        case FieldKind::fixed:
+            if (layout.size > remaining) {
+                return DecodeError::truncated;
+            }
+            fieldSize = layout.size;
+            break;
+        case FieldKind::string:
+            fieldSize = getTerminatedSize(data + offset, remaining);
+            if (fieldSize == 0) {
+                return DecodeError::unterminatedString;
+            }
+            break;
+        case FieldKind::caseInsensitiveString: {
+            const std::size_t keySize = getTerminatedSize(data + offset,
+                    remaining);
+            const std::size_t valueSize = keySize == 0 ? 0 : getTerminatedSize(
+                    data + offset + keySize, remaining - keySize);
+            if (valueSize == 0) {
+                return DecodeError::unterminatedString;
+            }
+            fieldSize = keySize + valueSize;
+            break;
+        }
+        case FieldKind::dictionaryCode: {
+            if (remaining == 0) {
+                return DecodeError::truncated;
+            }
+            const std::size_t codeSize = getOrderedVarintSize(data[offset]);
+            if (codeSize == 0) {
+                return DecodeError::invalidData;
+            }
+            if (codeSize > remaining) {
+                return DecodeError::truncated;
+            }
+            fieldSize = codeSize;
+            if (decodeOrderedVarint(data + offset) % 2 == 0) {
+                const std::size_t missingValueSize = getTerminatedSize(
+                        data + offset + codeSize, remaining - codeSize);
+                if (missingValueSize == 0) {
+                    return DecodeError::unterminatedString;
+                }
+                fieldSize += missingValueSize;
+            }
+            break;
+        }
+        }
+        offset += fieldSize;
+    }
+    return DecodeError::none;
+}
+
+//----------------------------------------------------------------------------//
+} // namespace detail
+} // namespace serialization
+//============================================================================//
+
+#endif // SERIALIZATION_DETAIL_VALIDATION_HPP
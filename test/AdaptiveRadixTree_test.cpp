@@ -0,0 +1,271 @@
+#include <serialization/AdaptiveRadixTree.hpp>
+#include <serialization/Serial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using Serial = serialization::Serial<>;
+using Tree = serialization::AdaptiveRadixTree<int>;
+using Bytes = std::vector<unsigned char>;
+using Reference = std::map<Bytes, int>;
+using Entries = std::vector<std::pair<Bytes, int>>;
+
+Bytes toBytes(const serialization::SerialView& key) {
+    return Bytes(key.data(), key.data() + key.size());
+}
+
+Serial makeKey(std::int8_t group, std::int32_t id) {
+    Serial serial;
+    serial << group << id;
+    return serial;
+}
+
+Serial makeKey(std::int8_t group, const std::string& name) {
+    Serial serial;
+    serial << group << name;
+    return serial;
+}
+
+Entries collect(const Reference& reference, const Bytes& low,
+        const Bytes* high) {
+    Entries entries;
+    for (const auto& entry : reference) {
+        if (!(entry.first < low) && (high == nullptr || entry.first < *high)) {
+            entries.push_back(entry);
+        }
+    }
+    return entries;
+}
+
+struct Collector {
+    void operator()(const serialization::SerialView& key, int value) {
+        entries.emplace_back(toBytes(key), value);
+    }
+
+    Entries& entries;
+};
+
+void checkSameContents(const Tree& tree, const Reference& reference) {
+    ASSERT_EQ(reference.size(), tree.size());
+    Entries entries;
+    tree.forEach(Collector{entries});
+    EXPECT_EQ(collect(reference, Bytes{}, nullptr), entries);
+    for (const auto& entry : reference) {
+        const int* value = tree.find(entry.first);
+        ASSERT_NE(nullptr, value);
+        EXPECT_EQ(entry.second, *value);
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+TEST(AdaptiveRadixTreeTest, EmptyTree) {
+    Tree tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(nullptr, tree.find(makeKey(1, 2)));
+    EXPECT_FALSE(tree.erase(makeKey(1, 2)));
+    Entries entries;
+    tree.forEach(Collector{entries});
+    EXPECT_TRUE(entries.empty());
+}
+
+TEST(AdaptiveRadixTreeTest, InsertFindAndReplace) {
+    Tree tree;
+    EXPECT_TRUE(tree.insert(makeKey(1, 2), 12));
+    EXPECT_TRUE(tree.insert(makeKey(1, 3), 13));
+    EXPECT_FALSE(tree.insert(makeKey(1, 2), 21));
+    EXPECT_EQ(2u, tree.size());
+    EXPECT_EQ(21, *tree.find(makeKey(1, 2)));
+    EXPECT_EQ(13, *tree.find(makeKey(1, 3)));
+    EXPECT_EQ(nullptr, tree.find(makeKey(1, 4)));
+    EXPECT_EQ(nullptr, tree.find(makeKey(2, 2)));
+}
+
+TEST(AdaptiveRadixTreeTest, EmptyKey) {
+    Tree tree;
+    EXPECT_TRUE(tree.insert(makeKey(1, 2), 12));
+    EXPECT_TRUE(tree.insert(serialization::SerialView{}, 1));
+    EXPECT_TRUE(tree.insert(makeKey(1, 3), 13));
+    EXPECT_EQ(1, *tree.find(serialization::SerialView{}));
+    EXPECT_TRUE(tree.erase(serialization::SerialView{}));
+    EXPECT_EQ(nullptr, tree.find(serialization::SerialView{}));
+    EXPECT_EQ(13, *tree.find(makeKey(1, 3)));
+}
+
+struct alignas(64) OverAligned {
+    int value;
+};
+
+TEST(AdaptiveRadixTreeTest, OverAlignedValues) {
+    serialization::AdaptiveRadixTree<OverAligned> tree;
+    for (std::int32_t id = 0; id < 20; ++id) {
+        tree.insert(makeKey(1, id), OverAligned{id});
+    }
+    for (std::int32_t id = 0; id < 20; ++id) {
+        const OverAligned* value = tree.find(makeKey(1, id));
+        ASSERT_NE(nullptr, value);
+        EXPECT_EQ(id, value->value);
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(value) % 64);
+    }
+}
+
+TEST(AdaptiveRadixTreeTest, KeysBeingPrefixesOfEachOther) {
+    Tree tree;
+    Reference reference;
+    const std::vector<std::string> names{"", "a", "ab", "abc", "abd", "b",
+            "abcdefghijklmnop", "abcdefghijklmnoq"};
+    int value = 0;
+    for (const std::string& name : names) {
+        const Serial key = makeKey(1, name);
+        // The name without its terminator is a prefix of the longer names.
+        const serialization::SerialView unterminated{key.data(),
+                key.size() - 1};
+        tree.insert(key, value);
+        reference[toBytes(key)] = value++;
+        tree.insert(unterminated, value);
+        reference[toBytes(unterminated)] = value++;
+    }
+    checkSameContents(tree, reference);
+}
+
+TEST(AdaptiveRadixTreeTest, MatchesMapUnderRandomUpdates) {
+    std::mt19937 random{42};
+    for (std::int32_t range : {10, 300, 5000}) {
+        Tree tree;
+        Reference reference;
+        std::uniform_int_distribution<std::int32_t> ids{-range, range};
+        std::uniform_int_distribution<int> groups{-2, 2};
+        for (int i = 0; i < 20000; ++i) {
+            const Serial key = makeKey(static_cast<std::int8_t>(groups(random)),
+                    ids(random));
+            if (random() % 3 == 0) {
+                EXPECT_EQ(reference.erase(toBytes(key)) == 1, tree.erase(key));
+            } else {
+                EXPECT_EQ(reference.count(toBytes(key)) == 0,
+                        tree.insert(key, i));
+                reference[toBytes(key)] = i;
+            }
+        }
+        checkSameContents(tree, reference);
+
+        // Erasing everything shrinks the tree back to nothing.
+        for (const auto& entry : reference) {
+            EXPECT_TRUE(tree.erase(entry.first));
+        }
+        EXPECT_TRUE(tree.empty());
+        Entries entries;
+        tree.forEach(Collector{entries});
+        EXPECT_TRUE(entries.empty());
+    }
+}
+
+// Paths longer than the prefix stored in a node are split and merged.
+TEST(AdaptiveRadixTreeTest, MatchesMapWithLongSharedPrefixes) {
+    std::mt19937 random{7};
+    std::uniform_int_distribution<std::size_t> lengths{0, 40};
+    std::uniform_int_distribution<int> letters{'a', 'c'};
+    Tree tree;
+    Reference reference;
+    for (int i = 0; i < 20000; ++i) {
+        std::string name(lengths(random), 'x');
+        for (std::size_t j = name.size() / 2; j < name.size(); ++j) {
+            if (random() % 4 == 0) {
+                name[j] = static_cast<char>(letters(random));
+            }
+        }
+        const Serial key = makeKey(1, name);
+        if (random() % 3 == 0) {
+            EXPECT_EQ(reference.erase(toBytes(key)) == 1, tree.erase(key));
+        } else {
+            EXPECT_EQ(reference.count(toBytes(key)) == 0, tree.insert(key, i));
+            reference[toBytes(key)] = i;
+        }
+    }
+    checkSameContents(tree, reference);
+
+    const Serial prefix = makeKey(1, std::string(20, 'x'));
+    const serialization::SerialView unterminated{prefix.data(),
+            prefix.size() - 1};
+    Entries entries;
+    tree.scanPrefix(unterminated, Collector{entries});
+    Bytes high = toBytes(unterminated);
+    ++high.back();
+    EXPECT_EQ(collect(reference, toBytes(unterminated), &high), entries);
+    EXPECT_EQ(nullptr, tree.find(makeKey(1, std::string(41, 'x'))));
+}
+
+TEST(AdaptiveRadixTreeTest, ScanPrefix) {
+    Tree tree;
+    Reference reference;
+    int value = 0;
+    for (std::int8_t group : {-1, 0, 1}) {
+        for (const char* name : {"apple", "apricot", "banana", "ap", "a"}) {
+            const Serial key = makeKey(group, name);
+            tree.insert(key, value);
+            reference[toBytes(key)] = value++;
+        }
+    }
+
+    Serial groupPrefix;
+    groupPrefix << std::int8_t{0};
+    Serial next;
+    next << std::int8_t{1};
+    Entries entries;
+    tree.scanPrefix(groupPrefix, Collector{entries});
+    const Bytes high = toBytes(next);
+    EXPECT_EQ(collect(reference, toBytes(groupPrefix), &high), entries);
+    EXPECT_EQ(5u, entries.size());
+
+    // A prefix ending inside of a compressed path.
+    const Serial ap = makeKey(0, "ap");
+    entries.clear();
+    tree.scanPrefix(serialization::SerialView{ap.data(), ap.size() - 1},
+            Collector{entries});
+    ASSERT_EQ(3u, entries.size());
+    EXPECT_EQ(reference[toBytes(ap)], entries[0].second);
+    EXPECT_EQ(reference[toBytes(makeKey(0, "apple"))], entries[1].second);
+    EXPECT_EQ(reference[toBytes(makeKey(0, "apricot"))], entries[2].second);
+
+    entries.clear();
+    tree.scanPrefix(makeKey(5, "a"), Collector{entries});
+    EXPECT_TRUE(entries.empty());
+}
+
+TEST(AdaptiveRadixTreeTest, ScanRange) {
+    std::mt19937 random{7};
+    std::uniform_int_distribution<std::int32_t> ids{-1000, 1000};
+    Tree tree;
+    Reference reference;
+    for (int i = 0; i < 2000; ++i) {
+        const Serial key = makeKey(static_cast<std::int8_t>(i % 3),
+                ids(random));
+        tree.insert(key, i);
+        reference[toBytes(key)] = i;
+    }
+    for (int i = 0; i < 200; ++i) {
+        Bytes low = toBytes(makeKey(static_cast<std::int8_t>(random() % 3),
+                ids(random)));
+        Bytes high = toBytes(makeKey(static_cast<std::int8_t>(random() % 3),
+                ids(random)));
+        if (high < low) {
+            std::swap(low, high);
+        }
+        Entries entries;
+        tree.scanRange(low, high, Collector{entries});
+        EXPECT_EQ(collect(reference, low, &high), entries);
+    }
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
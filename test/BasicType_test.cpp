@@ -1,3 +1,4 @@
+#include <serialization/Decimal.hpp>
 #include <serialization/Sequentialize.hpp>
 #include <serialization/Serial.hpp>
 
@@ -6,6 +7,8 @@
 #include <boost/endian/conversion.hpp>
 #include <boost/mpl/vector.hpp>
 
+#include <chrono>
+#include <cmath>
 #include <limits>
 #include <type_traits>
 #include <vector>
@@ -100,15 +103,15 @@ protected:
         sequentializer.pack(data);
         double unpackedData;
         sequentializer.unpack(unpackedData);
-        if (isnan(data)) {
-            EXPECT_TRUE(isnan(unpackedData));
+        if (std::isnan(data)) {
+            EXPECT_TRUE(std::isnan(unpackedData));
         } else {
             EXPECT_EQ(data, unpackedData);
         }
     }
 
     const std::vector<std::pair<double, double>> testData{{1.0, 0.0},
-            {0.034354543, -1.0}, {0.1, NAN},
+            {0.034354543, -1.0}, {NAN, 0.1}, {-1.0, -2.0},
             {12312434830249234123123.345453, -34345435345343454354.1234454564},
             {std::numeric_limits<double>::max(),
                     std::numeric_limits<double>::infinity() * -1},
@@ -116,7 +119,10 @@ protected:
             {NAN, std::numeric_limits<double>::infinity() * -1},
             {std::numeric_limits<double>::infinity(),
                     std::numeric_limits<double>::max()},
-            {0.3435453653432423423, std::numeric_limits<double>::min()}};
+            {0.3435453653432423423, std::numeric_limits<double>::min()},
+            {NAN, std::numeric_limits<double>::infinity()},
+            {std::numeric_limits<double>::min(), 0.0},
+            {-0.0, -std::numeric_limits<double>::min()}};
 };
 
 //----------------------------------------------------------------------------//
@@ -139,19 +145,313 @@ TEST_F(DoubleTest, SerializeAndCompareData) {
         double data1, data2;
         serial1 >> data1;
         serial2 >> data2;
-        if (isnan(data1)) {
-            EXPECT_TRUE(isnan(pair.first));
+        if (std::isnan(data1)) {
+            EXPECT_TRUE(std::isnan(pair.first));
         } else {
             EXPECT_EQ(pair.first, data1);
         }
-        if (isnan(data2)) {
-            EXPECT_TRUE(isnan(pair.second));
+        if (std::isnan(data2)) {
+            EXPECT_TRUE(std::isnan(pair.second));
         } else {
             EXPECT_EQ(pair.second, data2);
         }
     }
 }
 
+TEST_F(DoubleTest, NegativeZeroAndNanAreNormalized) {
+    serialization::Serial<> zero, negativeZero, nan, negativeNan;
+    zero << 0.0;
+    negativeZero << -0.0;
+    nan << std::numeric_limits<double>::quiet_NaN();
+    negativeNan << -std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(zero, negativeZero);
+    EXPECT_EQ(nan, negativeNan);
+}
+
+//============================================================================//
+
+template<typename UnsignedInt>
+class SequentializeUnsignedIntTest : public ::testing::Test {
+protected:
+    const std::vector<std::pair<std::uint64_t, std::uint64_t>> testData{
+        {1, 0}, {5, 1}, {200, 140}, {std::numeric_limits<std::uint8_t>::max(),
+                std::numeric_limits<std::int8_t>::max()},
+        {60000, 5430}, {std::numeric_limits<std::uint16_t>::max(), 0},
+        {4000000000U, 324354534},
+        {std::numeric_limits<std::uint32_t>::max(), 1},
+        {18000000000000000000UL, 3234534656456452323UL},
+        {std::numeric_limits<std::uint64_t>::max(),
+                std::numeric_limits<std::uint64_t>::max() - 1}};
+};
+
+TYPED_TEST_CASE_P(SequentializeUnsignedIntTest);
+
+//----------------------------------------------------------------------------//
+
+TYPED_TEST_P(SequentializeUnsignedIntTest, SerializeAndCompareData) {
+    for (const auto& pair : this->testData) {
+        if (pair.first <= std::numeric_limits<TypeParam>::max()) {
+            serialization::Serial<> serial1, serial2;
+            serial1 << static_cast<TypeParam>(pair.first);
+            serial2 << static_cast<TypeParam>(pair.second);
+            EXPECT_GT(serial1, serial2);
+            TypeParam data1, data2;
+            serial1 >> data1;
+            serial2 >> data2;
+            EXPECT_EQ(pair.first, data1);
+            EXPECT_EQ(pair.second, data2);
+        }
+    }
+}
+
+TYPED_TEST_P(SequentializeUnsignedIntTest, UsesNativeWidth) {
+    serialization::Sequentializer<serialization::StronglyTypedIntegers>
+            sequentializer;
+    sequentializer.pack(std::numeric_limits<TypeParam>::max());
+    TypeParam value = 0;
+    sequentializer.unpack(value);
+    EXPECT_EQ(std::numeric_limits<TypeParam>::max(), value);
+    EXPECT_DEATH({sequentializer.unpack(value);}, "Cannot unpack more data.");
+}
+
+//----------------------------------------------------------------------------//
+
+REGISTER_TYPED_TEST_CASE_P(SequentializeUnsignedIntTest,
+        SerializeAndCompareData, UsesNativeWidth);
+
+using PackableUnsignedIntTypes = ::testing::Types<std::uint8_t, std::uint16_t,
+        std::uint32_t, std::uint64_t>;
+
+INSTANTIATE_TYPED_TEST_CASE_P(PackableUnsignedIntTestcase,
+        SequentializeUnsignedIntTest, PackableUnsignedIntTypes);
+
+//============================================================================//
+
+TEST(FloatTest, SerializeAndCompareData) {
+    const std::vector<std::pair<float, float>> testData{{1.0f, 0.0f},
+            {-1.0f, -2.5f}, {0.5f, -0.5f}, {NAN, 3.0e38f},
+            {std::numeric_limits<float>::infinity(),
+                    std::numeric_limits<float>::max()},
+            {-std::numeric_limits<float>::max(),
+                    -std::numeric_limits<float>::infinity()}};
+    for (const auto& pair : testData) {
+        serialization::Serial<> serial1, serial2;
+        serial1 << pair.first;
+        serial2 << pair.second;
+        EXPECT_GT(serial1, serial2) << "Original pair: {" << pair.first
+                << ", " << pair.second << "}";
+        float data1, data2;
+        serial1 >> data1;
+        serial2 >> data2;
+        if (std::isnan(pair.first)) {
+            EXPECT_TRUE(std::isnan(data1));
+        } else {
+            EXPECT_EQ(pair.first, data1);
+        }
+        EXPECT_EQ(pair.second, data2);
+    }
+}
+
+TEST(BoolTest, SerializeAndCompareData) {
+    serialization::Serial<> serialTrue, serialFalse;
+    serialTrue << true;
+    serialFalse << false;
+    EXPECT_GT(serialTrue, serialFalse);
+    bool valueTrue = false, valueFalse = true;
+    serialTrue >> valueTrue;
+    serialFalse >> valueFalse;
+    EXPECT_TRUE(valueTrue);
+    EXPECT_FALSE(valueFalse);
+}
+
+TEST(CharTest, OrderedLikeStrings) {
+    serialization::Serial<> serial1, serial2, serial3;
+    serial1 << '\xe9';
+    serial2 << 'z';
+    serial3 << 'a';
+    EXPECT_GT(serial1, serial2);
+    EXPECT_GT(serial2, serial3);
+    char value = 0;
+    serial1 >> value;
+    EXPECT_EQ('\xe9', value);
+}
+
+#ifdef SERIALIZATION_HAS_INT128
+TEST(Int128Test, SerializeAndCompareData) {
+    using serialization::detail::int128_t;
+    using serialization::detail::uint128_t;
+    const int128_t big = static_cast<int128_t>(1) << 100;
+    const std::vector<std::pair<int128_t, int128_t>> testData{{0, -1},
+            {big, std::numeric_limits<std::int64_t>::max()}, {-5, -big},
+            {big, -big}};
+    for (const auto& pair : testData) {
+        serialization::Serial<> serial1, serial2;
+        serial1 << pair.first;
+        serial2 << pair.second;
+        EXPECT_GT(serial1, serial2);
+        int128_t data1 = 0, data2 = 0;
+        serial1 >> data1;
+        serial2 >> data2;
+        EXPECT_TRUE(pair.first == data1);
+        EXPECT_TRUE(pair.second == data2);
+    }
+
+    serialization::Serial<> serial1, serial2;
+    const uint128_t huge = ~static_cast<uint128_t>(0);
+    serial1 << huge;
+    serial2 << static_cast<uint128_t>(big);
+    EXPECT_GT(serial1, serial2);
+    uint128_t data = 0;
+    serial1 >> data;
+    EXPECT_TRUE(huge == data);
+}
+#endif
+
+//============================================================================//
+
+TEST(DecimalTest, SerializeAndCompareData) {
+    using Money = serialization::Decimal<18, 4>;
+    static_assert(std::is_same<Money::Storage, std::int64_t>::value,
+            "Unexpected storage");
+    static_assert(std::is_same<serialization::Decimal<4, 2>::Storage,
+            std::int16_t>::value, "Unexpected storage");
+
+    const std::vector<std::pair<Money, Money>> testData{
+            {Money{1}, Money{0}}, {Money{-1}, Money{-2}},
+            {Money{123456789012345678}, Money{-123456789012345678}},
+            {Money{100000}, Money{99999}}};
+    for (const auto& pair : testData) {
+        serialization::Serial<> serial1, serial2;
+        serial1 << pair.first;
+        serial2 << pair.second;
+        EXPECT_GT(serial1, serial2);
+        Money data1, data2;
+        serial1 >> data1;
+        serial2 >> data2;
+        EXPECT_EQ(pair.first, data1);
+        EXPECT_EQ(pair.second, data2);
+    }
+}
+
+TEST(DecimalTest, UsesStorageWidth) {
+    serialization::Sequentializer<serialization::StronglyTypedIntegers>
+            sequentializer;
+    sequentializer.pack(serialization::Decimal<4, 2>{-9999});
+    std::int16_t value = 0;
+    sequentializer.unpack(value);
+    EXPECT_EQ(-9999, value);
+    EXPECT_DEATH({sequentializer.unpack(value);}, "Cannot unpack more data.");
+}
+
+TEST(DecimalTest, ScalesAreDifferentTypes) {
+    serialization::Serial<> serial;
+    serial << serialization::Decimal<9, 2>{150};
+    EXPECT_EQ(3u + 4, serial.size()); // a long type id
+    serialization::Decimal<9, 4> otherScale;
+    EXPECT_DEATH({serial >> otherScale;},
+            "Type Id does not match with the expected one.");
+
+    ASSERT_EQ(serialization::DecodeError::none, serial.validate());
+    serial >> otherScale;
+    EXPECT_EQ(serialization::DecodeError::typeMismatch,
+            serial.getDecodeError());
+}
+
+TEST(ChronoTest, SerializeAndCompareTimePoints) {
+    using TimePoint = std::chrono::time_point<std::chrono::system_clock,
+            std::chrono::nanoseconds>;
+    const TimePoint epoch{};
+    const std::vector<std::pair<TimePoint, TimePoint>> testData{
+            {epoch + std::chrono::nanoseconds{1}, epoch},
+            {epoch - std::chrono::nanoseconds{1},
+                    epoch - std::chrono::hours{24 * 365}},
+            {epoch + std::chrono::seconds{1700000000},
+                    epoch + std::chrono::nanoseconds{1699999999999999999}}};
+    for (const auto& pair : testData) {
+        serialization::Serial<> serial1, serial2;
+        serial1 << pair.first;
+        serial2 << pair.second;
+        EXPECT_GT(serial1, serial2);
+        TimePoint data1, data2;
+        serial1 >> data1;
+        serial2 >> data2;
+        EXPECT_EQ(pair.first, data1);
+        EXPECT_EQ(pair.second, data2);
+    }
+}
+
+TEST(ChronoTest, SerializeAndCompareDurations) {
+    serialization::Serial<> serial1, serial2;
+    serial1 << std::chrono::milliseconds{5};
+    serial2 << std::chrono::milliseconds{-5};
+    EXPECT_GT(serial1, serial2);
+    std::chrono::milliseconds data{0};
+    serial2 >> data;
+    EXPECT_EQ(std::chrono::milliseconds{-5}, data);
+}
+
+TEST(ChronoTest, UnitsAreDifferentTypes) {
+    serialization::Serial<> serial;
+    serial << std::chrono::nanoseconds{1500};
+    ASSERT_EQ(serialization::DecodeError::none, serial.validate());
+    std::chrono::seconds seconds{7};
+    serial >> seconds;
+    EXPECT_EQ(serialization::DecodeError::typeMismatch,
+            serial.getDecodeError());
+    EXPECT_EQ(std::chrono::seconds{7}, seconds);
+
+    serial.rewind();
+    serial.validate();
+    std::chrono::duration<std::int32_t, std::nano> nanoseconds{0};
+    serial >> nanoseconds;
+    EXPECT_EQ(1500, nanoseconds.count());
+}
+
+TEST(ChronoTest, WholeRangeOfCoarseUnits) {
+    using Seconds = std::chrono::time_point<std::chrono::system_clock,
+            std::chrono::seconds>;
+    const Seconds after2262{std::chrono::seconds{10000000000}};
+    const std::chrono::seconds max = std::chrono::seconds::max();
+    serialization::Serial<> serial1, serial2;
+    serial1 << after2262 << max;
+    serial2 << after2262 << std::chrono::seconds{max.count() - 1};
+    EXPECT_GT(serial1, serial2);
+
+    Seconds timePoint;
+    std::chrono::seconds seconds{0};
+    serial1 >> timePoint >> seconds;
+    EXPECT_EQ(after2262, timePoint);
+    EXPECT_EQ(max, seconds);
+}
+
+TEST(ChronoTest, NarrowTickCountsSaturate) {
+    using Milliseconds = std::chrono::duration<std::int32_t, std::milli>;
+    serialization::Serial<> serial;
+    serial << std::chrono::milliseconds{std::int64_t{1} << 40}
+            << std::chrono::milliseconds{-(std::int64_t{1} << 40)};
+    Milliseconds high{0};
+    Milliseconds low{0};
+    serial >> high >> low;
+    EXPECT_EQ(Milliseconds::max(), high);
+    EXPECT_EQ(Milliseconds::min(), low);
+}
+
+TEST(ChronoTest, ClocksAreDifferentTypes) {
+    serialization::Serial<> serial;
+    serial << std::chrono::steady_clock::time_point{};
+    std::chrono::system_clock::time_point timePoint;
+    EXPECT_DEATH({serial >> timePoint;},
+            "Type Id does not match with the expected one.");
+}
+
+TEST(ChronoTest, AbortsOnTypeMismatch) {
+    serialization::Serial<> serial;
+    serial << std::chrono::seconds{1};
+    std::chrono::system_clock::time_point timePoint;
+    EXPECT_DEATH({serial >> timePoint;},
+            "Type Id does not match with the expected one.");
+}
+
 //============================================================================//
 
 class StringTest : public ::testing::Test {
@@ -173,6 +473,17 @@ TEST_F(StringTest, PackAndUnpack) {
     }
 }
 
+TEST_F(StringTest, UnpackFollowingData) {
+    serialization::Serial<> serial;
+    serial << std::string{"abc"} << std::int16_t{-3} << std::string{};
+    std::string first, second{"x"};
+    std::int16_t number = 0;
+    serial >> first >> number >> second;
+    EXPECT_EQ("abc", first);
+    EXPECT_EQ(-3, number);
+    EXPECT_EQ("", second);
+}
+
 // TODO: add int tests including promotion
 
 //----------------------------------------------------------------------------//
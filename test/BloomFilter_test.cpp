@@ -0,0 +1,107 @@
+#include <serialization/BloomFilter.hpp>
+#include <serialization/Serial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using Serial = serialization::Serial<>;
+
+Serial makeKey(std::int32_t tenant, std::int64_t id) {
+    Serial serial;
+    serial << tenant << id;
+    return serial;
+}
+
+constexpr std::size_t TENANT_PREFIX_SIZE = 1 + sizeof(std::int32_t);
+
+//----------------------------------------------------------------------------//
+
+TEST(BloomFilterTest, NoFalseNegativesAndFewFalsePositives) {
+    serialization::BloomFilterBuilder builder;
+    for (std::int64_t id = 0; id < 10000; ++id) {
+        builder.add(makeKey(1, id * 2));
+    }
+    const serialization::detail::ByteSequence filter = builder.finish();
+    EXPECT_EQ(0u, filter.size() % 64);
+
+    // Read from another buffer, like a mapped file would be.
+    const std::vector<unsigned char> mapped(filter.begin(), filter.end());
+    const serialization::BloomFilterReader reader{mapped.data(),
+            mapped.size()};
+    ASSERT_TRUE(reader.isValid());
+    std::size_t falsePositives = 0;
+    for (std::int64_t id = 0; id < 10000; ++id) {
+        EXPECT_TRUE(reader.mayContain(makeKey(1, id * 2)));
+        falsePositives += reader.mayContain(makeKey(1, id * 2 + 1));
+    }
+    // About 1% is expected with 10 bits per key.
+    EXPECT_LT(falsePositives, 250u);
+}
+
+TEST(BloomFilterTest, PrefixFilter) {
+    serialization::BloomFilterBuilder builder{10, TENANT_PREFIX_SIZE};
+    for (std::int32_t tenant = 0; tenant < 1000; tenant += 2) {
+        for (std::int64_t id = 0; id < 5; ++id) {
+            builder.add(makeKey(tenant, id));
+        }
+    }
+    const serialization::detail::ByteSequence filter = builder.finish();
+    const serialization::BloomFilterReader reader{filter.data(),
+            filter.size()};
+    ASSERT_EQ(TENANT_PREFIX_SIZE, reader.getPrefixSize());
+
+    std::size_t falsePositives = 0;
+    for (std::int32_t tenant = 0; tenant < 1000; ++tenant) {
+        Serial prefix;
+        prefix << tenant;
+        if (tenant % 2 == 0) {
+            EXPECT_TRUE(reader.mayContainPrefix(prefix));
+            EXPECT_TRUE(reader.mayContain(makeKey(tenant, 3)));
+        } else {
+            falsePositives += reader.mayContainPrefix(prefix);
+        }
+    }
+    EXPECT_LT(falsePositives, 50u);
+
+    // Shorter prefixes cannot be filtered.
+    const Serial tenantOnly = makeKey(1, 0);
+    EXPECT_TRUE(reader.mayContainPrefix(serialization::SerialView{
+            tenantOnly.data(), TENANT_PREFIX_SIZE - 1}));
+}
+
+TEST(BloomFilterTest, InvalidFilterHidesNothing) {
+    serialization::BloomFilterBuilder builder;
+    builder.add(makeKey(1, 1));
+    serialization::detail::ByteSequence filter = builder.finish();
+
+    const serialization::BloomFilterReader truncated{filter.data(),
+            filter.size() - 1};
+    EXPECT_FALSE(truncated.isValid());
+    EXPECT_TRUE(truncated.mayContain(makeKey(2, 2)));
+
+    filter[0] = 'X';
+    const serialization::BloomFilterReader corrupt{filter.data(),
+            filter.size()};
+    EXPECT_FALSE(corrupt.isValid());
+    EXPECT_TRUE(corrupt.mayContain(makeKey(2, 2)));
+}
+
+TEST(BloomFilterTest, EmptyFilter) {
+    const serialization::detail::ByteSequence filter =
+            serialization::BloomFilterBuilder{}.finish();
+    const serialization::BloomFilterReader reader{filter.data(),
+            filter.size()};
+    ASSERT_TRUE(reader.isValid());
+    EXPECT_FALSE(reader.mayContain(makeKey(1, 1)));
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
@@ -0,0 +1,103 @@
+#include <serialization/CaseInsensitiveString.hpp>
+#include <serialization/Serial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using serialization::CaseInsensitiveString;
+
+class CaseInsensitiveStringTest : public ::testing::Test {
+protected:
+    static serialization::Serial<> serialize(const std::string& value) {
+        serialization::Serial<> serial;
+        serial << CaseInsensitiveString{value};
+        return serial;
+    }
+
+    static std::string fold(const std::string& value) {
+        serialization::Sequentializer<serialization::StronglyTypedIntegers>
+                sequentializer;
+        sequentializer.pack(CaseInsensitiveString{value});
+        std::string folded;
+        sequentializer.unpack(folded); // the primary weights come first
+        return folded;
+    }
+};
+
+//----------------------------------------------------------------------------//
+
+TEST_F(CaseInsensitiveStringTest, PackAndUnpack) {
+    for (const std::string& value : {std::string{}, std::string{"Abc"},
+                 std::string{"\xc3\x89t\xc3\xa9"},
+                 std::string{"broken \xff\xc3 utf-8"}}) {
+        serialization::Serial<> serial;
+        serial << CaseInsensitiveString{value} << std::int32_t{42};
+        CaseInsensitiveString recreatedValue;
+        std::int32_t number = 0;
+        serial >> recreatedValue >> number;
+        EXPECT_EQ(value, recreatedValue.str());
+        EXPECT_EQ(42, number);
+    }
+}
+
+TEST_F(CaseInsensitiveStringTest, IgnoresCaseFirst) {
+    EXPECT_LT(serialize("apple"), serialize("Banana"));
+    EXPECT_LT(serialize("Banana"), serialize("cherry"));
+    EXPECT_LT(serialize("ab"), serialize("AB_"));
+    EXPECT_LT(serialize("\xc3\xa0 la carte"), serialize("\xc3\x80 LA CARTF"));
+    EXPECT_LT(serialize("\xce\xb1\xce\xb2"), serialize("\xce\x91\xce\x93"));
+}
+
+TEST_F(CaseInsensitiveStringTest, BreaksTiesByOriginal) {
+    EXPECT_NE(serialize("ABC"), serialize("abc"));
+    EXPECT_LT(serialize("ABC"), serialize("abc"));
+    EXPECT_LT(serialize("abc"), serialize("ABD"));
+    EXPECT_EQ(serialize("abc"), serialize("abc"));
+}
+
+TEST_F(CaseInsensitiveStringTest, SortsLikeFoldedStrings) {
+    std::vector<std::string> values{"The QUICK brown fox jumps", "the lazy dog",
+            "THE QUICK BROWN FOX JUMPS OVER", "zebra", "Zebra", "[bracket]",
+            "the quick brown fox jumps over the lazy dog",
+            "THE QUICK BROWN FOX JUMPS OVER THE LAZY CAT"};
+    auto folded = [](std::string value) {
+        std::transform(value.begin(), value.end(), value.begin(),
+                [](char c) { return c >= 'A' && c <= 'Z' ? c + 32 : c; });
+        return value;
+    };
+    std::sort(values.begin(), values.end(),
+            [&](const std::string& lhs, const std::string& rhs) {
+                const std::string foldedLhs = folded(lhs);
+                const std::string foldedRhs = folded(rhs);
+                return foldedLhs != foldedRhs ? foldedLhs < foldedRhs :
+                        lhs < rhs;
+            });
+    for (std::size_t i = 1; i < values.size(); ++i) {
+        EXPECT_LT(serialize(values[i - 1]), serialize(values[i]))
+                << values[i - 1] << " vs " << values[i];
+    }
+}
+
+TEST_F(CaseInsensitiveStringTest, FoldsUnicode) {
+    EXPECT_EQ(fold("HELLO, WORLD! 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ"),
+            "hello, world! 0123456789 abcdefghijklmnopqrstuvwxyz");
+    EXPECT_EQ(fold("\xc3\x89T\xc3\x89 \xc5\xb8"), // ÉTÉ Ÿ
+            "\xc3\xa9t\xc3\xa9 \xc3\xbf");
+    EXPECT_EQ(fold("\xce\xa3\xce\x9f\xce\xa6\xce\x99\xce\x91"), // ΣΟΦΙΑ
+            "\xcf\x83\xce\xbf\xcf\x86\xce\xb9\xce\xb1");
+    EXPECT_EQ(fold("\xd0\x9c\xd0\xbe\xd1\x81\xd0\xba\xd0\xb2\xd0\xb0"), // Москва
+            "\xd0\xbc\xd0\xbe\xd1\x81\xd0\xba\xd0\xb2\xd0\xb0");
+    EXPECT_EQ(fold("\xc5\xbf\xc3\x9f"), "s\xc3\x9f"); // ſß
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
@@ -0,0 +1,85 @@
+#include <serialization/Dictionary.hpp>
+#include <serialization/Serial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+class DictionaryTest : public ::testing::Test {
+protected:
+    serialization::Serial<> serialize(const std::string& value) const {
+        serialization::Serial<> serial;
+        serial << dictionary.encode(value);
+        return serial;
+    }
+
+    std::string deserialize(serialization::Serial<>& serial) const {
+        serialization::DictionaryCode code;
+        serial >> code;
+        return dictionary.decode(code);
+    }
+
+    const std::vector<std::string> sample{"DE", "US", "HU", "FR", "US", "AT"};
+    const serialization::OrderPreservingDictionary dictionary{sample.begin(),
+            sample.end()};
+};
+
+//----------------------------------------------------------------------------//
+
+TEST_F(DictionaryTest, BuildsSortedUniqueValues) {
+    EXPECT_EQ((std::vector<std::string>{"AT", "DE", "FR", "HU", "US"}),
+            dictionary.getValues());
+}
+
+TEST_F(DictionaryTest, PackAndUnpack) {
+    for (const char* value : {"AT", "HU", "US", "", "A", "CH", "ZZ"}) {
+        serialization::Serial<> serial = serialize(value);
+        serial << std::int8_t{7};
+        EXPECT_EQ(value, deserialize(serial));
+        std::int8_t next = 0;
+        serial >> next;
+        EXPECT_EQ(7, next);
+    }
+}
+
+TEST_F(DictionaryTest, KnownValuesTakeOneByte) {
+    serialization::Serial<> serial = serialize("US");
+    EXPECT_EQ(3u + 1, serial.size()); // type tag and one byte
+}
+
+TEST_F(DictionaryTest, PreservesOrder) {
+    const std::vector<std::string> values{"", "A", "AT", "ATA", "B", "DE",
+            "FR", "FRA", "HU", "UR", "US", "USA", "ZZ"};
+    for (std::size_t i = 1; i < values.size(); ++i) {
+        EXPECT_LT(serialize(values[i - 1]), serialize(values[i]))
+                << values[i - 1] << " vs " << values[i];
+    }
+}
+
+TEST(OrderedVarintTest, PreservesOrderAcrossLengths) {
+    const std::vector<std::uint32_t> values{0, 1, 0x7F, 0x80, 0x81, 0x407F,
+            0x4080, 0x4081, 0x20407F, 0x204080, 0x1234567,
+            serialization::detail::MAX_ORDERED_VARINT};
+    std::vector<serialization::detail::byte> previous;
+    for (std::uint32_t value : values) {
+        serialization::detail::byte buffer[4];
+        std::size_t size = serialization::detail::encodeOrderedVarint(value,
+                buffer);
+        EXPECT_EQ(size, serialization::detail::getOrderedVarintSize(buffer[0]));
+        EXPECT_EQ(value, serialization::detail::decodeOrderedVarint(buffer));
+        std::vector<serialization::detail::byte> current(buffer,
+                buffer + size);
+        EXPECT_LT(previous, current);
+        previous = current;
+    }
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
@@ -0,0 +1,141 @@
+#include <serialization/Hash.hpp>
+#include <serialization/Serial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using Serial = serialization::Serial<>;
+using serialization::detail::byte;
+
+TEST(HashTest, Multiply) {
+    std::uint64_t low = 0xFFFFFFFFFFFFFFFFULL;
+    std::uint64_t high = 0xFFFFFFFFFFFFFFFFULL;
+    serialization::detail::multiply(low, high);
+    EXPECT_EQ(1u, low);
+    EXPECT_EQ(0xFFFFFFFFFFFFFFFEULL, high);
+
+    low = 0x123456789ABCDEF0ULL;
+    high = 0x10;
+    serialization::detail::multiply(low, high);
+    EXPECT_EQ(0x23456789ABCDEF00ULL, low);
+    EXPECT_EQ(0x1u, high);
+}
+
+TEST(HashTest, EveryByteAndLengthMatters) {
+    std::vector<byte> data(100);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<byte>(i * 7);
+    }
+    std::set<std::uint64_t> hashes;
+    std::size_t count = 0;
+    for (std::size_t size = 0; size <= data.size(); ++size) {
+        hashes.insert(serialization::detail::hashBytes(data.data(), size));
+        ++count;
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] ^= 1;
+            hashes.insert(serialization::detail::hashBytes(data.data(), size));
+            data[i] ^= 1;
+            ++count;
+        }
+    }
+    EXPECT_EQ(count, hashes.size());
+}
+
+TEST(HashTest, SeedChangesTheHash) {
+    Serial key;
+    key << std::int32_t{42} << std::string{"key"};
+    EXPECT_EQ(serialization::hash(key), serialization::hash(key, 0));
+    EXPECT_NE(serialization::hash(key, 1), serialization::hash(key, 2));
+}
+
+TEST(HashTest, HashFollowsTheBytes) {
+    Serial key;
+    key << std::int32_t{42};
+    const std::uint64_t first = key.hash();
+    EXPECT_EQ(serialization::hash(key), first);
+
+    key << std::string{"more"};
+    EXPECT_NE(first, key.hash());
+    EXPECT_EQ(serialization::hash(key), key.hash());
+
+    key.reset();
+    key << std::int32_t{42};
+    EXPECT_EQ(first, key.hash());
+    EXPECT_EQ(serialization::SerialHash{}(key),
+            serialization::SerialHash{}(serialization::SerialView{key}));
+}
+
+TEST(HashTest, HashedKey) {
+    using HashedKey = serialization::HashedKey<Serial>;
+    Serial serial;
+    serial << std::int32_t{42} << std::string{"key"};
+    const std::uint64_t expected = serial.hash();
+    HashedKey key{std::move(serial)};
+    EXPECT_EQ(expected, key.hash());
+    EXPECT_EQ(expected, serialization::SerialHash{}(key));
+
+    HashedKey moved{std::move(key)};
+    EXPECT_EQ(expected, moved.hash());
+    EXPECT_EQ(serialization::hash(serialization::SerialView{key.get()}),
+            key.hash());
+
+    std::unordered_set<HashedKey, serialization::SerialHash> keys;
+    keys.insert(std::move(moved));
+    Serial probe;
+    probe << std::int32_t{42} << std::string{"key"};
+    EXPECT_EQ(1u, keys.count(HashedKey{std::move(probe)}));
+}
+
+TEST(HashTest, UnorderedSetOfSerials) {
+    std::unordered_set<Serial, serialization::SerialHash> keys;
+    for (std::int32_t i = 0; i < 10; ++i) {
+        Serial key;
+        key << i << std::string{"key"};
+        keys.insert(std::move(key));
+    }
+    Serial probe;
+    probe << std::int32_t{7} << std::string{"key"};
+    EXPECT_EQ(1u, keys.count(probe));
+    probe << std::int8_t{0};
+    EXPECT_EQ(0u, keys.count(probe));
+}
+
+TEST(HashTest, Batch) {
+    std::vector<byte> buffer;
+    std::vector<std::size_t> offsets{0};
+    std::vector<serialization::SerialView> views;
+    for (std::int32_t i = 0; i < 50; ++i) {
+        Serial key;
+        key << i << std::string(static_cast<std::size_t>(i), 'x');
+        buffer.insert(buffer.end(), key.data(), key.data() + key.size());
+        offsets.push_back(buffer.size());
+    }
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+        views.emplace_back(buffer.data() + offsets[i],
+                offsets[i + 1] - offsets[i]);
+    }
+
+    std::vector<std::uint64_t> fromOffsets(views.size());
+    std::vector<std::uint64_t> fromViews(views.size());
+    serialization::hashBatch(buffer.data(), offsets.data(), views.size(),
+            fromOffsets.data(), 3);
+    serialization::hashBatch(views.data(), views.size(), fromViews.data(), 3);
+    for (std::size_t i = 0; i < views.size(); ++i) {
+        EXPECT_EQ(serialization::hash(views[i], 3), fromOffsets[i]);
+        EXPECT_EQ(serialization::hash(views[i], 3), fromViews[i]);
+    }
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
@@ -0,0 +1,128 @@
+#include <serialization/KeyBatch.hpp>
+#include <serialization/Serial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using Serial = serialization::Serial<>;
+using serialization::detail::ByteSequence;
+
+ByteSequence makeKey(const std::string& table, std::int64_t id) {
+    Serial serial;
+    serial << table << id;
+    return serial.release();
+}
+
+std::vector<ByteSequence> makeSortedKeys() {
+    std::mt19937_64 random{3};
+    std::vector<ByteSequence> keys;
+    for (const char* table : {"", "orders", "orders_archive", "users"}) {
+        std::int64_t id = -5000;
+        for (int i = 0; i < 500; ++i) {
+            id += static_cast<std::int64_t>(random() % (i < 250 ? 3 : 100000));
+            keys.push_back(makeKey(table, id));
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+ByteSequence encode(const std::vector<ByteSequence>& keys,
+        bool deltaIntegers) {
+    serialization::KeyBatchEncoder encoder{deltaIntegers};
+    for (const ByteSequence& key : keys) {
+        encoder.add(key);
+    }
+    EXPECT_EQ(keys.size(), encoder.size());
+    return encoder.finish();
+}
+
+//----------------------------------------------------------------------------//
+
+class KeyBatchTest : public ::testing::TestWithParam<bool> {
+};
+
+TEST_P(KeyBatchTest, RoundTrip) {
+    const std::vector<ByteSequence> keys = makeSortedKeys();
+    const ByteSequence batch = encode(keys, GetParam());
+    std::size_t totalSize = 0;
+    for (const ByteSequence& key : keys) {
+        totalSize += key.size();
+    }
+    EXPECT_LT(batch.size(), totalSize / 3);
+
+    serialization::KeyBatchDecoder decoder{batch.data(), batch.size()};
+    Serial key;
+    std::size_t index = 0;
+    while (decoder.next(key)) {
+        ASSERT_LT(index, keys.size());
+        EXPECT_EQ(serialization::SerialView{keys[index]},
+                serialization::SerialView{key});
+        ++index;
+    }
+    EXPECT_EQ(keys.size(), index);
+    EXPECT_TRUE(decoder.isExhausted());
+    EXPECT_EQ(serialization::DecodeError::none, decoder.getDecodeError());
+}
+
+TEST_P(KeyBatchTest, DuplicateAndPrefixKeys) {
+    std::vector<ByteSequence> keys{makeKey("a", 1), makeKey("a", 1)};
+    keys.emplace_back(keys[0].begin(), keys[0].end() - 3);
+    std::sort(keys.begin(), keys.end());
+    const ByteSequence batch = encode(keys, GetParam());
+
+    serialization::KeyBatchDecoder decoder{batch.data(), batch.size()};
+    serialization::SerialView key;
+    for (const ByteSequence& expected : keys) {
+        ASSERT_TRUE(decoder.next(key));
+        EXPECT_EQ(serialization::SerialView{expected}, key);
+    }
+    EXPECT_FALSE(decoder.next(key));
+}
+
+TEST_P(KeyBatchTest, CorruptData) {
+    const std::vector<ByteSequence> keys = makeSortedKeys();
+    const ByteSequence batch = encode(keys, GetParam());
+
+    // Every cut is either at a key boundary or reported.
+    for (std::size_t size = 0; size < 200; ++size) {
+        serialization::KeyBatchDecoder decoder{batch.data(), size};
+        serialization::SerialView key;
+        while (decoder.next(key)) {
+        }
+        EXPECT_TRUE(decoder.isExhausted() || decoder.getDecodeError() ==
+                serialization::DecodeError::truncated);
+    }
+
+    // A shared prefix longer than the previous key.
+    const serialization::detail::byte invalid[] = {5, 2, 'x'};
+    serialization::KeyBatchDecoder decoder{invalid, sizeof(invalid)};
+    serialization::SerialView key;
+    EXPECT_FALSE(decoder.next(key));
+    EXPECT_EQ(serialization::DecodeError::invalidData,
+            decoder.getDecodeError());
+}
+
+INSTANTIATE_TEST_CASE_P(DeltaIntegers, KeyBatchTest,
+        ::testing::Values(false, true));
+
+TEST(KeyBatchDeltaTest, DeltasMakeSequentialIdsSmaller) {
+    std::vector<ByteSequence> keys;
+    for (std::int64_t id = 0; id < 100000; id += 300) {
+        keys.push_back(makeKey("t", id));
+    }
+    EXPECT_LT(encode(keys, true).size(), encode(keys, false).size());
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
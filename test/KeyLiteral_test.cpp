@@ -0,0 +1,88 @@
+#include <serialization/Decimal.hpp>
+#include <serialization/KeyLiteral.hpp>
+#include <serialization/Serial.hpp>
+#include <serialization/SerialView.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <set>
+#include <string>
+#include <utility>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using serialization::Decimal;
+using serialization::Serial;
+using serialization::SerialView;
+using serialization::encodeKey;
+using serialization::detail::byte;
+
+constexpr auto prefix = encodeKey(std::int8_t{3}, std::int32_t{42});
+
+static_assert(prefix.size() == 2 + 5, "Wrong size of the key literal!");
+static_assert(prefix[0] == 0x80 && prefix[1] == 0x83 && prefix[2] == 0x82 &&
+        prefix[3] == 0x80 && prefix[4] == 0 && prefix[5] == 0 &&
+        prefix[6] == 42, "Wrong bytes of the key literal!");
+static_assert(encodeKey().empty(), "An empty key has no bytes!");
+
+template <typename... Values>
+void expectSameBytes(const Values&... values) {
+    const auto key = encodeKey(values...);
+    Serial<> serial;
+    static_cast<void>(std::initializer_list<int>{(serial << values, 0)...});
+    EXPECT_EQ(SerialView{serial}, SerialView{key});
+}
+
+//----------------------------------------------------------------------------//
+
+TEST(KeyLiteralTest, SameBytesAsSerial) {
+    expectSameBytes(std::int8_t{-3}, std::int16_t{-300}, std::int32_t{7},
+            std::int64_t{-1});
+    expectSameBytes(std::uint8_t{200}, std::uint16_t{60000},
+            std::uint32_t{1} << 31, ~std::uint64_t{0});
+    expectSameBytes(true, 'x', 2.5, -1.5f);
+    expectSameBytes(Decimal<9, 2>{12345}, Decimal<30, 4>{-7},
+            std::chrono::nanoseconds{-5});
+    expectSameBytes(std::chrono::system_clock::time_point{
+            std::chrono::seconds{1500000000}});
+}
+
+#ifdef SERIALIZATION_HAS_INT128
+TEST(KeyLiteralTest, Int128) {
+    constexpr auto key = encodeKey(
+            -(serialization::detail::int128_t{1} << 100));
+    static_assert(key.size() == 3 + 16, "Wrong size of the key literal!");
+    expectSameBytes(-(serialization::detail::int128_t{1} << 100),
+            serialization::detail::uint128_t{12345} << 64 | 678);
+}
+#endif
+
+TEST(KeyLiteralTest, Prefix) {
+    std::set<Serial<>, serialization::SerialLess> keys;
+    for (std::int8_t tenant = 2; tenant <= 4; ++tenant) {
+        for (std::int32_t table = 41; table <= 43; ++table) {
+            Serial<> key;
+            key << tenant << table << std::string{"row"};
+            keys.insert(std::move(key));
+        }
+    }
+
+    const auto first = keys.lower_bound(SerialView{prefix});
+    ASSERT_NE(keys.end(), first);
+    SerialView found{*first};
+    ASSERT_LT(prefix.size(), found.size());
+    EXPECT_EQ(SerialView{prefix}, SerialView(found.data(), prefix.size()));
+
+    constexpr auto after = encodeKey(std::int8_t{3}, std::int32_t{43});
+    EXPECT_EQ(std::next(first), keys.lower_bound(SerialView{after}));
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
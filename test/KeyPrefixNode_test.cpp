@@ -0,0 +1,86 @@
+#include <serialization/KeyPrefixNode.hpp>
+#include <serialization/Serial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using Serial = serialization::Serial<>;
+
+class KeyPrefixNodeTest : public ::testing::Test {
+protected:
+    static Serial makeKey(std::int16_t group, std::int64_t id,
+            const std::string& name) {
+        Serial serial;
+        serial << group << id << name;
+        return serial;
+    }
+
+    void checkAllProbes(const std::vector<Serial>& keys,
+            const std::vector<Serial>& probes) {
+        const serialization::KeyPrefixNode node{keys.begin(), keys.end()};
+        ASSERT_EQ(keys.size(), node.size());
+        for (const Serial& probe : probes) {
+            const std::size_t expected = std::lower_bound(keys.begin(),
+                    keys.end(), probe) - keys.begin();
+            EXPECT_EQ(expected, node.lowerBound(probe));
+        }
+    }
+};
+
+//----------------------------------------------------------------------------//
+
+TEST_F(KeyPrefixNodeTest, EmptyNode) {
+    serialization::KeyPrefixNode node;
+    EXPECT_EQ(0u, node.lowerBound(makeKey(1, 2, "x")));
+}
+
+TEST_F(KeyPrefixNodeTest, MatchesLowerBound) {
+    std::mt19937 random{42};
+    for (std::size_t size : {1, 3, 7, 64, 255}) {
+        std::vector<Serial> keys;
+        std::vector<Serial> probes;
+        for (std::size_t i = 0; i < size; ++i) {
+            // few distinct prefixes, so that the whole keys are compared too
+            const std::int16_t group = random() % 4 - 2;
+            const std::int64_t id = random() % 16;
+            keys.push_back(makeKey(group, id, std::to_string(random() % 8)));
+            probes.push_back(makeKey(group, id, std::to_string(random() % 8)));
+        }
+        probes.push_back(Serial{});
+        probes.push_back(makeKey(-32768, 0, ""));
+        probes.push_back(makeKey(32767, 0, ""));
+        std::sort(keys.begin(), keys.end());
+        checkAllProbes(keys, probes);
+        for (const Serial& key : keys) {
+            Serial copy;
+            copy.adopt(serialization::detail::ByteSequence(key.data(),
+                    key.data() + key.size()));
+            probes.push_back(std::move(copy));
+        }
+        checkAllProbes(keys, probes);
+    }
+}
+
+TEST_F(KeyPrefixNodeTest, ShortKeys) {
+    std::vector<Serial> keys(4);
+    keys[1] << std::int8_t{-1};
+    keys[2] << std::int8_t{0};
+    keys[3] << std::int8_t{0} << std::int8_t{0};
+    std::vector<Serial> probes(3);
+    probes[1] << std::int8_t{0};
+    probes[2] << std::int8_t{1};
+    checkAllProbes(keys, probes);
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
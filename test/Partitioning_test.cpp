@@ -0,0 +1,104 @@
+#include <serialization/Partitioning.hpp>
+#include <serialization/Serial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using Serial = serialization::Serial<>;
+using serialization::detail::ByteSequence;
+
+ByteSequence makeKey(std::int64_t id, const std::string& name = {}) {
+    Serial serial;
+    serial << id << name;
+    return serial.release();
+}
+
+//----------------------------------------------------------------------------//
+
+TEST(PartitioningTest, SamplerKeepsCapacity) {
+    serialization::KeySampler sampler{100};
+    for (std::int64_t id = 0; id < 50; ++id) {
+        sampler.add(makeKey(id));
+    }
+    EXPECT_EQ(50u, sampler.getSample().size());
+    for (std::int64_t id = 50; id < 100000; ++id) {
+        sampler.add(makeKey(id));
+    }
+    EXPECT_EQ(100000u, sampler.getSeenCount());
+    EXPECT_EQ(100u, sampler.getSample().size());
+}
+
+TEST(PartitioningTest, BalancedPartitions) {
+    std::mt19937_64 random{1};
+    std::vector<ByteSequence> keys;
+    for (int i = 0; i < 100000; ++i) {
+        // Skewed: most of the keys are small.
+        keys.push_back(makeKey(static_cast<std::int64_t>(random() % 1000) *
+                static_cast<std::int64_t>(random() % 1000) - 1000));
+    }
+    serialization::KeySampler sampler{2000, 42};
+    for (const ByteSequence& key : keys) {
+        sampler.add(key);
+    }
+    const serialization::RangePartitioner partitioner =
+            sampler.computePartitioner(8);
+    ASSERT_EQ(8u, partitioner.getPartitionCount());
+
+    std::vector<std::size_t> sizes(partitioner.getPartitionCount());
+    for (const ByteSequence& key : keys) {
+        ++sizes[partitioner.getPartition(key)];
+    }
+    for (std::size_t size : sizes) {
+        EXPECT_GT(size, keys.size() / 8 * 3 / 4);
+        EXPECT_LT(size, keys.size() / 8 * 5 / 4);
+    }
+}
+
+TEST(PartitioningTest, LookupMatchesUpperBound) {
+    // Long common prefixes, so the whole keys have to be compared.
+    std::vector<ByteSequence> boundaries;
+    for (std::int64_t id : {-5, 0, 0, 3, 7}) {
+        for (const char* name : {"", "a", "b"}) {
+            boundaries.push_back(makeKey(id, name));
+        }
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    const serialization::RangePartitioner partitioner{boundaries};
+
+    for (std::int64_t id = -7; id < 10; ++id) {
+        for (const char* name : {"", "0", "a", "aa", "b", "c"}) {
+            const ByteSequence key = makeKey(id, name);
+            const std::size_t expected = std::upper_bound(boundaries.begin(),
+                    boundaries.end(), key) - boundaries.begin();
+            EXPECT_EQ(expected, partitioner.getPartition(key));
+        }
+    }
+}
+
+TEST(PartitioningTest, HeavyKeyMergesBoundaries) {
+    serialization::KeySampler sampler{100};
+    for (int i = 0; i < 1000; ++i) {
+        sampler.add(makeKey(42));
+    }
+    const serialization::RangePartitioner partitioner =
+            sampler.computePartitioner(4);
+    EXPECT_EQ(2u, partitioner.getPartitionCount());
+    EXPECT_EQ(0u, partitioner.getPartition(makeKey(41)));
+    EXPECT_EQ(1u, partitioner.getPartition(makeKey(42)));
+
+    EXPECT_EQ(1u, serialization::KeySampler{10}.computePartitioner(4)
+            .getPartitionCount());
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
@@ -0,0 +1,178 @@
+#include <serialization/Payload.hpp>
+#include <serialization/Record.hpp>
+#include <serialization/Serial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/mpl/vector.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+struct Order {
+    std::int32_t id = 0;
+    std::string customer;
+    double amount = 0;
+
+    // One pair of hooks for both keys and payloads.
+    template <typename Serial>
+    void serialize(Serial& serial) const {
+        serial << id << customer << amount;
+    }
+
+    template <typename Serial>
+    void deserialize(Serial& serial) {
+        serial >> id >> customer >> amount;
+    }
+};
+
+using Types = boost::mpl::vector<Order>;
+using Payload = serialization::Payload<Types>;
+using Serial = serialization::Serial<Types>;
+
+//----------------------------------------------------------------------------//
+
+TEST(PayloadTest, RoundTrip) {
+    using Duration = std::chrono::nanoseconds;
+    using Price = serialization::Decimal<9, 2>;
+
+    Payload payload;
+    payload << std::int8_t{-1} << std::uint16_t{65535} << std::int64_t{-7}
+            << -0.5f << std::numeric_limits<double>::infinity() << true
+            << 'x' << std::string{} << std::string{"hello\0world", 11}
+            << serialization::CaseInsensitiveString{"MiXed"}
+            << serialization::DictionaryCode{4, "missing"}
+            << serialization::DictionaryCode{7} << Price{-12345}
+            << Duration{123456789};
+
+    std::int8_t int8 = 0;
+    std::uint16_t uint16 = 0;
+    std::int64_t int64 = 0;
+    float single = 0;
+    double infinity = 0;
+    bool boolean = false;
+    char character = 0;
+    std::string empty{"x"};
+    std::string withNull;
+    serialization::CaseInsensitiveString mixed;
+    serialization::DictionaryCode missing;
+    serialization::DictionaryCode found;
+    Price price;
+    Duration duration;
+    payload >> int8 >> uint16 >> int64 >> single >> infinity >> boolean
+            >> character >> empty >> withNull >> mixed >> missing >> found
+            >> price >> duration;
+
+    EXPECT_EQ(-1, int8);
+    EXPECT_EQ(65535, uint16);
+    EXPECT_EQ(-7, int64);
+    EXPECT_EQ(-0.5f, single);
+    EXPECT_TRUE(std::isinf(infinity));
+    EXPECT_TRUE(boolean);
+    EXPECT_EQ('x', character);
+    EXPECT_EQ("", empty);
+    EXPECT_EQ(std::string("hello\0world", 11), withNull);
+    EXPECT_EQ("MiXed", mixed.str());
+    EXPECT_EQ(serialization::DictionaryCode(4, "missing"), missing);
+    EXPECT_EQ(serialization::DictionaryCode(7), found);
+    EXPECT_EQ(Price{-12345}, price);
+    EXPECT_EQ(Duration{123456789}, duration);
+}
+
+TEST(PayloadTest, LittleEndianAndUntagged) {
+    Payload payload;
+    payload << std::int32_t{0x01020304} << std::string{"ab"};
+    const serialization::detail::byte expected[] = {4, 3, 2, 1, 2, 'a', 'b'};
+    ASSERT_EQ(sizeof(expected), payload.size());
+    EXPECT_EQ(0, std::memcmp(expected, payload.data(), sizeof(expected)));
+}
+
+TEST(PayloadTest, SameHooksAsKeys) {
+    const Order order{42, "ACME", 99.5};
+    Serial key;
+    key << order;
+    Payload payload;
+    payload << order;
+    EXPECT_LT(payload.size(), key.size());
+
+    Order fromKey;
+    Order fromPayload;
+    key >> fromKey;
+    payload >> fromPayload;
+    EXPECT_EQ(order.id, fromPayload.id);
+    EXPECT_EQ(order.customer, fromPayload.customer);
+    EXPECT_EQ(order.amount, fromPayload.amount);
+    EXPECT_EQ(fromKey.customer, fromPayload.customer);
+}
+
+//----------------------------------------------------------------------------//
+
+TEST(RecordTest, KeyAndPayloadInOneBuffer) {
+    serialization::RecordBuilder<Types> builder;
+    for (std::int32_t id : {1, 2}) {
+        builder.key() << std::int16_t{7} << id;
+        builder.payload() << Order{id, "customer", 1.5 * id};
+        const serialization::RecordView record{builder.getRecord()};
+        ASSERT_TRUE(record.isValid());
+
+        Serial expectedKey;
+        expectedKey << std::int16_t{7} << id;
+        EXPECT_EQ(serialization::SerialView{expectedKey}, record.getKey());
+
+        Payload payload{reinterpret_cast<const char*>(
+                record.getPayload().data()), record.getPayload().size()};
+        Order order;
+        payload >> order;
+        EXPECT_EQ(id, order.id);
+        EXPECT_EQ(1.5 * id, order.amount);
+        builder.clear();
+    }
+
+    builder.key() << std::int16_t{1};
+    const serialization::detail::ByteSequence keyOnly = builder.finish();
+    const serialization::RecordView record{keyOnly.data(), keyOnly.size()};
+    ASSERT_TRUE(record.isValid());
+    EXPECT_EQ(3u, record.getKey().size());
+    EXPECT_EQ(0u, record.getPayload().size());
+}
+
+TEST(RecordTest, KeyHoldsOnlyTheKey) {
+    serialization::RecordBuilder<Types> builder;
+    builder.key() << std::int16_t{7} << std::string{"id"};
+    Serial expectedKey;
+    expectedKey << std::int16_t{7} << std::string{"id"};
+    EXPECT_EQ(serialization::SerialView{expectedKey},
+            serialization::SerialView{builder.key()});
+    EXPECT_EQ(serialization::DecodeError::none, builder.key().validate());
+
+    // The payload can still grow after the record was looked at.
+    builder.payload() << std::int32_t{1};
+    const std::size_t size = builder.getRecord().size();
+    builder.payload() << std::int32_t{2};
+    const serialization::RecordView record{builder.getRecord()};
+    ASSERT_TRUE(record.isValid());
+    EXPECT_EQ(size + 4, builder.getRecord().size());
+    EXPECT_EQ(serialization::SerialView{expectedKey}, record.getKey());
+    EXPECT_EQ(8u, record.getPayload().size());
+}
+
+TEST(RecordTest, InvalidRecords) {
+    const serialization::detail::byte tooShort[] = {1, 0, 0};
+    EXPECT_FALSE(serialization::RecordView(tooShort, sizeof(tooShort))
+            .isValid());
+    const serialization::detail::byte keyTooLong[] = {'a', 2, 0, 0, 0};
+    EXPECT_FALSE(serialization::RecordView(keyTooLong, sizeof(keyTooLong))
+            .isValid());
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
@@ -0,0 +1,153 @@
+#include <serialization/Payload.hpp>
+#include <serialization/Reflection.hpp>
+#include <serialization/Serial.hpp>
+#include <serialization/SerialView.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/mpl/vector.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+struct Price {
+    std::int64_t units;
+    std::int32_t nanos;
+};
+
+struct Trade {
+    std::int32_t account;
+    std::int64_t timestamp;
+    double quantity;
+    std::string symbol;
+    Price price;
+    bool buy;
+    std::chrono::microseconds latency;
+};
+
+// The same layout with hand-written hooks.
+struct ManualTrade {
+    std::int32_t account;
+    std::int64_t timestamp;
+    double quantity;
+    std::string symbol;
+    Price price;
+    bool buy;
+    std::chrono::microseconds latency;
+
+    template <typename Serial>
+    void serialize(Serial& serial) const {
+        serial << account << timestamp << quantity << symbol << price << buy
+               << latency;
+    }
+
+    template <typename Serial>
+    void deserialize(Serial& serial) {
+        serial >> account >> timestamp >> quantity >> symbol >> price >> buy
+               >> latency;
+    }
+};
+
+struct Empty {
+};
+
+using Serial = serialization::Serial<boost::mpl::vector<Trade, Price, Empty>>;
+using ManualSerial =
+        serialization::Serial<boost::mpl::vector<ManualTrade, Price>>;
+
+static_assert(serialization::detail::getFieldCount<Price>() == 2, "");
+static_assert(serialization::detail::getFieldCount<Trade>() == 7, "");
+static_assert(serialization::detail::getFieldCount<Empty>() == 0, "");
+static_assert(!serialization::detail::IsReflectable<ManualTrade,
+        boost::mpl::vector<ManualTrade>,
+        serialization::StronglyTypedIntegers>::value, "");
+
+const Trade trade{42, 1500000000, 2.5, "ACME", {-3, 250}, true,
+        std::chrono::microseconds{17}};
+
+void expectEqual(const Trade& expected, const Trade& actual) {
+    EXPECT_EQ(expected.account, actual.account);
+    EXPECT_EQ(expected.timestamp, actual.timestamp);
+    EXPECT_EQ(expected.quantity, actual.quantity);
+    EXPECT_EQ(expected.symbol, actual.symbol);
+    EXPECT_EQ(expected.price.units, actual.price.units);
+    EXPECT_EQ(expected.price.nanos, actual.price.nanos);
+    EXPECT_EQ(expected.buy, actual.buy);
+    EXPECT_EQ(expected.latency, actual.latency);
+}
+
+//----------------------------------------------------------------------------//
+
+TEST(ReflectionTest, RoundTrip) {
+    Serial serial;
+    serial << trade << Empty{} << std::int8_t{5};
+    Trade result{};
+    Empty empty;
+    std::int8_t last = 0;
+    serial >> result >> empty >> last;
+    expectEqual(trade, result);
+    EXPECT_EQ(5, last);
+}
+
+TEST(ReflectionTest, SameBytesAsHandWrittenHooks) {
+    Serial serial;
+    serial << trade;
+    ManualSerial manualSerial;
+    manualSerial << ManualTrade{trade.account, trade.timestamp,
+            trade.quantity, trade.symbol, trade.price, trade.buy,
+            trade.latency};
+    EXPECT_EQ(serialization::SerialView{manualSerial},
+            serialization::SerialView{serial});
+}
+
+TEST(ReflectionTest, PreservesOrder) {
+    Serial lhs;
+    lhs << Price{-3, 999};
+    Serial rhs;
+    rhs << Price{-2, 0};
+    EXPECT_LT(lhs, rhs);
+}
+
+TEST(ReflectionTest, Payload) {
+    serialization::Payload<boost::mpl::vector<Trade, Price>> payload;
+    payload << trade;
+    Trade result{};
+    payload >> result;
+    expectEqual(trade, result);
+}
+
+TEST(ReflectionTest, ValidatedDecoding) {
+    Serial serial;
+    serial << trade;
+    Trade result{};
+    ASSERT_EQ(serialization::DecodeError::none, serial.validate());
+    serial >> result;
+    EXPECT_EQ(serialization::DecodeError::none, serial.getDecodeError());
+    expectEqual(trade, result);
+
+    Serial mismatch;
+    mismatch << Price{1, 2};
+    ASSERT_EQ(serialization::DecodeError::none, mismatch.validate());
+    mismatch >> result;
+    EXPECT_EQ(serialization::DecodeError::typeMismatch,
+            mismatch.getDecodeError());
+}
+
+TEST(ReflectionTest, AbortsOnTypeMismatchInRun) {
+    Serial serial;
+    serial << Price{1, 2};
+    serial.rewind();
+    std::int32_t units = 0;
+    std::int32_t nanos = 0;
+    EXPECT_DEATH({serial.unpackFixedWidths(units, nanos);},
+            "Type Id does not match with the expected one.");
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
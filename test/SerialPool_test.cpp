@@ -0,0 +1,175 @@
+#include <serialization/Serial.hpp>
+#include <serialization/SerialPool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+std::atomic<std::size_t> allocationCount{0};
+
+} // unnamed namespace
+
+// Counts the allocations of the whole test binary.
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+namespace {
+
+using Serial = serialization::Serial<>;
+
+//----------------------------------------------------------------------------//
+
+TEST(SerialResetTest, ResetKeepsCapacity) {
+    Serial serial;
+    serial << std::string(100, 'x');
+    const std::size_t capacity = serial.capacity();
+    const serialization::detail::byte* data = serial.data();
+    serial.reset();
+    EXPECT_EQ(0u, serial.size());
+    EXPECT_EQ(capacity, serial.capacity());
+    serial << std::int32_t{5};
+    EXPECT_EQ(data, serial.data());
+    std::int32_t value = 0;
+    serial >> value;
+    EXPECT_EQ(5, value);
+}
+
+TEST(SerialResetTest, RewindReadsAgain) {
+    Serial serial;
+    serial << std::int64_t{-3} << std::string{"abc"};
+    for (int i = 0; i < 2; ++i) {
+        std::int64_t number = 0;
+        std::string text;
+        serial >> number >> text;
+        EXPECT_EQ(-3, number);
+        EXPECT_EQ("abc", text);
+        serial.rewind();
+    }
+}
+
+TEST(SerialResetTest, ReleaseAndAdoptDoNotCopy) {
+    Serial serial;
+    serial << std::string{"moved"};
+    const serialization::detail::byte* data = serial.data();
+    serialization::detail::ByteSequence bytes = serial.release();
+    EXPECT_EQ(0u, serial.size());
+    EXPECT_EQ(data, bytes.data());
+
+    Serial other;
+    other.adopt(std::move(bytes));
+    EXPECT_EQ(data, other.data());
+    std::string text;
+    other >> text;
+    EXPECT_EQ("moved", text);
+}
+
+TEST(SerialPoolTest, ReusesBuffers) {
+    serialization::SerialPool<Serial> pool{128, 2};
+    const serialization::detail::byte* data = nullptr;
+    {
+        auto serial = pool.acquire();
+        EXPECT_EQ(0u, serial->size());
+        EXPECT_LE(128u, serial->capacity());
+        *serial << std::int32_t{1};
+        data = serial->data();
+    }
+    EXPECT_EQ(1u, pool.size());
+    {
+        auto serial = pool.acquire();
+        EXPECT_EQ(0u, serial->size());
+        EXPECT_EQ(data, serial->data());
+        EXPECT_EQ(0u, pool.size());
+    }
+}
+
+TEST(SerialPoolTest, KeepsAtMostMaxSize) {
+    serialization::SerialPool<Serial> pool{16, 1};
+    {
+        auto first = pool.acquire();
+        auto second = pool.acquire();
+    }
+    EXPECT_EQ(1u, pool.size());
+}
+
+TEST(SerialPoolTest, RefillsReleasedBuffers) {
+    serialization::SerialPool<Serial> pool{128, 2};
+    {
+        auto serial = pool.acquire();
+        *serial << std::int32_t{1};
+        serial->release();
+    }
+    auto serial = pool.acquire();
+    EXPECT_LE(128u, serial->capacity());
+}
+
+TEST(SerialPoolTest, DropsHugeBuffers) {
+    serialization::SerialPool<Serial> pool{16, 2, 1024};
+    {
+        auto serial = pool.acquire();
+        *serial << std::string(4096, 'x');
+    }
+    EXPECT_EQ(0u, pool.size());
+}
+
+TEST(SerialPoolTest, NoAllocationOnceWarmedUp) {
+    serialization::SerialPool<Serial> pool{128, 2};
+    const std::string text(100, 'x');
+    {
+        auto first = pool.acquire();
+        auto second = pool.acquire();
+    }
+
+    const std::size_t allocations = allocationCount;
+    for (std::int32_t i = 0; i < 100; ++i) {
+        {
+            auto serial = pool.acquire();
+            *serial << i << text;
+        }
+        Serial first = pool.take();
+        Serial second = pool.take();
+        first << text;
+        second << i;
+        pool.giveBack(std::move(second));
+        pool.giveBack(std::move(first));
+    }
+    EXPECT_EQ(allocations, allocationCount);
+}
+
+TEST(SerialPoolTest, LocalPoolIsPerThread) {
+    auto& pool = serialization::SerialPool<Serial>::local();
+    EXPECT_EQ(&pool, &serialization::SerialPool<Serial>::local());
+    {
+        auto serial = pool.acquire();
+        *serial << std::string{"key"};
+    }
+    EXPECT_LE(1u, pool.size());
+
+    const serialization::SerialPool<Serial>* otherPool = nullptr;
+    std::thread thread{[&otherPool] {
+        otherPool = &serialization::SerialPool<Serial>::local();
+    }};
+    thread.join();
+    EXPECT_NE(&pool, otherPool);
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
@@ -0,0 +1,100 @@
+#include <serialization/Serial.hpp>
+#include <serialization/SerialView.hpp>
+#include <serialization/StackSerial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using Serial = serialization::Serial<>;
+
+Serial makeKey(std::int32_t id, const std::string& name) {
+    Serial serial;
+    serial << id << name;
+    return serial;
+}
+
+//----------------------------------------------------------------------------//
+
+TEST(StackSerialTest, MatchesSerial) {
+    Serial serial;
+    serial << std::int8_t{3} << std::uint64_t{42} << -1.5 << true <<
+            std::string{"abc"} << std::chrono::seconds{7};
+    serialization::StackSerial<64> stackSerial;
+    stackSerial << std::int8_t{3} << std::uint64_t{42} << -1.5 << true <<
+            "abc" << std::chrono::seconds{7};
+    EXPECT_EQ(serialization::SerialView{serial},
+            serialization::SerialView{stackSerial});
+}
+
+TEST(StackSerialTest, AbortsWhenFull) {
+    serialization::StackSerial<4> stackSerial;
+    stackSerial << std::int16_t{1};
+    EXPECT_DEATH({stackSerial << std::int16_t{2};},
+            "Key does not fit into the stack storage.");
+}
+
+TEST(SerialViewTest, OrdersLikeSerial) {
+    const Serial lhs = makeKey(1, "b");
+    const Serial rhs = makeKey(2, "a");
+    const Serial prefix = makeKey(1, "");
+    EXPECT_LT(lhs, rhs);
+    EXPECT_LT(serialization::SerialView{lhs}, serialization::SerialView{rhs});
+    EXPECT_LT(serialization::SerialView(prefix.data(), prefix.size() - 1),
+            serialization::SerialView{prefix});
+    EXPECT_EQ(serialization::SerialView{},
+            serialization::SerialView(lhs.data(), 0));
+}
+
+TEST(SerialLessTest, FindsInMapWithoutSerial) {
+    std::map<Serial, int, serialization::SerialLess> map;
+    map.emplace(makeKey(1, "one"), 1);
+    map.emplace(makeKey(2, "two"), 2);
+    map.emplace(makeKey(3, "three"), 3);
+
+    const Serial key = makeKey(2, "two");
+    const std::vector<serialization::detail::byte> buffer(key.data(),
+            key.data() + key.size());
+    auto found = map.find(serialization::SerialView{buffer});
+    ASSERT_NE(map.end(), found);
+    EXPECT_EQ(2, found->second);
+
+    found = map.find(std::make_pair(buffer.data(), buffer.size()));
+    ASSERT_NE(map.end(), found);
+    EXPECT_EQ(2, found->second);
+
+    serialization::StackSerial<32> probe;
+    probe << std::int32_t{3} << "three";
+    found = map.find(probe);
+    ASSERT_NE(map.end(), found);
+    EXPECT_EQ(3, found->second);
+
+    serialization::StackSerial<32> missing;
+    missing << std::int32_t{3} << "four";
+    EXPECT_EQ(map.end(), map.find(missing));
+}
+
+TEST(SerialLessTest, SearchesSortedVector) {
+    std::vector<Serial> keys;
+    for (std::int32_t i = 0; i < 10; ++i) {
+        keys.push_back(makeKey(i * 2, "x"));
+    }
+    serialization::StackSerial<32> probe;
+    probe << std::int32_t{7};
+    const auto position = std::lower_bound(keys.begin(), keys.end(), probe,
+            serialization::SerialLess{});
+    EXPECT_EQ(4, position - keys.begin());
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
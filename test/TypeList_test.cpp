@@ -0,0 +1,165 @@
+#include <serialization/Serial.hpp>
+#include <serialization/SerialView.hpp>
+#include <serialization/TypeList.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/mpl/vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using serialization::TypeList;
+using serialization::detail::Contains;
+using serialization::detail::ElementIndex;
+using serialization::detail::ToTypeList;
+
+static_assert(ElementIndex<TypeList<int, char, long>, char>::value == 1, "");
+static_assert(ElementIndex<TypeList<int, char>, long>::value == 2, "");
+static_assert(Contains<TypeList<int, char>, int>::value, "");
+static_assert(!Contains<TypeList<>, int>::value, "");
+static_assert(ElementIndex<TypeList<int, char, int>, int>::value == 3,
+        "Duplicates are not found.");
+static_assert(std::is_same<ToTypeList<boost::mpl::vector<int, char>>::type,
+        TypeList<int, char>>::value, "");
+
+//----------------------------------------------------------------------------//
+
+template <std::size_t Index>
+struct Registered {
+    std::int32_t value = 0;
+
+    template <typename Serial>
+    void serialize(Serial& serial) const {
+        serial << value;
+    }
+
+    template <typename Serial>
+    void deserialize(Serial& serial) {
+        serial >> value;
+    }
+};
+
+template <typename Indices>
+struct MakeRegistry;
+
+template <std::size_t... Indices>
+struct MakeRegistry<std::index_sequence<Indices...>> {
+    using type = TypeList<Registered<Indices>...>;
+};
+
+struct Named {
+    std::string name;
+
+    template <typename Serial>
+    void serialize(Serial& serial) const {
+        serial << name;
+    }
+
+    template <typename Serial>
+    void deserialize(Serial& serial) {
+        serial >> name;
+    }
+};
+
+// More types than an std::int8_t type id could tell apart.
+using Serial = serialization::Serial<
+        MakeRegistry<std::make_index_sequence<300>>::type>;
+
+template <std::size_t Index>
+Serial makeKey(std::int32_t value) {
+    Serial serial;
+    serial << Registered<Index>{value};
+    return serial;
+}
+
+//----------------------------------------------------------------------------//
+
+TEST(TypeListTest, MplSequencesGiveTheSameBytes) {
+    serialization::Serial<TypeList<Named>> serial;
+    serial << Named{"foo"} << std::int32_t{7};
+    serialization::Serial<boost::mpl::vector<Named>> mplSerial;
+    mplSerial << Named{"foo"} << std::int32_t{7};
+    EXPECT_EQ(serialization::SerialView{serial},
+            serialization::SerialView{mplSerial});
+
+    // The first registered type has id 6, std::string 5 and std::int32_t 2.
+    EXPECT_EQ(0x86, serial.data()[0]);
+    EXPECT_EQ(0x85, serial.data()[1]);
+    EXPECT_EQ(0x82, serial.data()[6]);
+}
+
+// Stored keys depend on these, they shall never change.
+TEST(TypeListTest, TypeIdsAreFixed) {
+    serialization::Serial<TypeList<Named>> serial;
+    serial << Named{""} << std::uint32_t{1} << std::int64_t{1};
+    EXPECT_EQ(0x86, serial.data()[0]);
+    EXPECT_EQ(0xFF, serial.data()[3]); // 129
+    EXPECT_EQ(0, serial.data()[4]);
+    EXPECT_EQ(2, serial.data()[5]);
+    EXPECT_EQ(0x83, serial.data()[10]);
+
+    // Registries of up to 120 types keep the one byte ids they always had.
+    EXPECT_EQ(125u, serialization::detail::getCustomTypeId(119));
+    Serial lastShort = makeKey<119>(0);
+    EXPECT_EQ(0x80 + 125, lastShort.data()[0]);
+    EXPECT_EQ(383u, serialization::detail::getCustomTypeId(120));
+    Serial firstLong = makeKey<120>(0);
+    EXPECT_EQ(0xFF, firstLong.data()[0]);
+    EXPECT_EQ(1, firstLong.data()[1]);
+    EXPECT_EQ(0, firstLong.data()[2]);
+}
+
+TEST(TypeListTest, LongTypeIds) {
+    Serial first = makeKey<0>(5);
+    Serial shortId = makeKey<50>(-1);
+    Serial longId = makeKey<200>(3);
+    Serial longerId = makeKey<299>(-7);
+    EXPECT_EQ(1u + 1 + 4, shortId.size());
+    EXPECT_EQ(3u + 1 + 4, longId.size());
+
+    // The order of the type ids is kept across both forms.
+    EXPECT_LT(first, shortId);
+    EXPECT_LT(shortId, longId);
+    EXPECT_LT(longId, longerId);
+
+    Registered<299> value;
+    longerId >> value;
+    EXPECT_EQ(-7, value.value);
+
+    ASSERT_EQ(serialization::DecodeError::none, longId.validate());
+    Registered<201> wrong;
+    longId >> wrong;
+    EXPECT_EQ(serialization::DecodeError::typeMismatch,
+            longId.getDecodeError());
+}
+
+TEST(TypeListTest, ValidationOfLongTypeIds) {
+    Serial serial = makeKey<250>(1);
+    std::string data{reinterpret_cast<const char*>(serial.data()),
+            serial.size()};
+
+    Serial truncated{data.data(), 2};
+    EXPECT_EQ(serialization::DecodeError::truncated, truncated.validate());
+
+    data[1] = '\xff';
+    Serial unknown{data.data(), data.size()};
+    EXPECT_EQ(serialization::DecodeError::unknownTypeId, unknown.validate());
+}
+
+TEST(TypeListTest, AbortsOnLongTypeIdMismatch) {
+    Serial serial = makeKey<150>(1);
+    Registered<151> wrong;
+    EXPECT_DEATH({serial >> wrong;},
+            "Type Id does not match with the expected one.");
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
@@ -0,0 +1,159 @@
+#include <serialization/Serial.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/mpl/vector.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+using serialization::DecodeError;
+
+struct Point {
+    std::int32_t x = 0;
+    std::int32_t y = 0;
+};
+
+using Serial = serialization::Serial<boost::mpl::vector<Point>>;
+
+void serialize(const Point& point, Serial& serial) {
+    serial << point.x << point.y;
+}
+
+void deserialize(Point& point, Serial& serial) {
+    serial >> point.x >> point.y;
+}
+
+class ValidationTest : public ::testing::Test {
+protected:
+    ValidationTest() {
+        original << std::string{"key"} << Point{} << 1.5 <<
+                serialization::CaseInsensitiveString{"Name"} <<
+                dictionary.encode("missing") << std::int64_t{-7};
+    }
+
+    Serial copy(std::size_t size) const {
+        return Serial{reinterpret_cast<const char*>(original.data()), size};
+    }
+
+    Serial original;
+    const serialization::OrderPreservingDictionary dictionary{
+            std::vector<std::string>{"known"}};
+};
+
+//----------------------------------------------------------------------------//
+
+TEST_F(ValidationTest, AcceptsValidData) {
+    Serial serial = copy(original.size());
+    ASSERT_EQ(DecodeError::none, serial.validate());
+
+    std::string key;
+    Point point{1, 1};
+    double number = 0;
+    serialization::CaseInsensitiveString name;
+    serialization::DictionaryCode code;
+    std::int64_t last = 0;
+    serial >> key >> point >> number >> name >> code >> last;
+    EXPECT_EQ(DecodeError::none, serial.getDecodeError());
+    EXPECT_EQ("key", key);
+    EXPECT_EQ(0, point.x);
+    EXPECT_EQ(1.5, number);
+    EXPECT_EQ("Name", name.str());
+    EXPECT_EQ("missing", dictionary.decode(code));
+    EXPECT_EQ(-7, last);
+}
+
+// Cutting at a field boundary gives valid data, which runs out on reading.
+TEST_F(ValidationTest, DetectsEveryTruncation) {
+    for (std::size_t size = 1; size < original.size(); ++size) {
+        Serial serial = copy(size);
+        if (serial.validate() == DecodeError::none) {
+            std::string key;
+            Point point;
+            double number = 0;
+            serialization::CaseInsensitiveString name;
+            serialization::DictionaryCode code;
+            std::int64_t last = 0;
+            serial >> key >> point >> number >> name >> code >> last;
+        }
+        EXPECT_NE(DecodeError::none, serial.getDecodeError()) << size;
+    }
+}
+
+TEST_F(ValidationTest, RejectsUnknownTypeId) {
+    Serial serial = copy(original.size());
+    serial << std::int8_t{0};
+    std::string data{reinterpret_cast<const char*>(serial.data()),
+            serial.size()};
+    data[original.size()] = '\x7f';
+    Serial corrupted{data.data(), data.size()};
+    EXPECT_EQ(DecodeError::unknownTypeId, corrupted.validate());
+}
+
+TEST_F(ValidationTest, ReportsTypeMismatch) {
+    Serial serial = copy(original.size());
+    ASSERT_EQ(DecodeError::none, serial.validate());
+    std::int64_t wrong = 3;
+    std::string key;
+    serial >> wrong >> key;
+    EXPECT_EQ(DecodeError::typeMismatch, serial.getDecodeError());
+    EXPECT_EQ(3, wrong);
+    EXPECT_EQ("", key);
+}
+
+TEST_F(ValidationTest, ReportsReadingPastTheEnd) {
+    Serial serial;
+    serial << std::int16_t{1};
+    ASSERT_EQ(DecodeError::none, serial.validate());
+    std::int16_t value = 0;
+    serial >> value >> value;
+    EXPECT_EQ(1, value);
+    EXPECT_EQ(DecodeError::truncated, serial.getDecodeError());
+}
+
+// Well-formed fields holding values which the type being read cannot have.
+TEST_F(ValidationTest, ReportsImpossibleValues) {
+    Serial boolean;
+    boolean << true << std::int8_t{1};
+    std::string data{reinterpret_cast<const char*>(boolean.data()),
+            boolean.size()};
+    data[3] = '\x02';
+    Serial corrupted{data.data(), data.size()};
+    ASSERT_EQ(DecodeError::none, corrupted.validate());
+    bool flag = false;
+    std::int8_t next = 0;
+    corrupted >> flag >> next;
+    EXPECT_EQ(DecodeError::invalidData, corrupted.getDecodeError());
+    EXPECT_FALSE(flag);
+    EXPECT_EQ(0, next);
+
+    Serial duration;
+    duration << std::chrono::milliseconds{std::int64_t{1} << 40};
+    ASSERT_EQ(DecodeError::none, duration.validate());
+    std::chrono::duration<std::int32_t, std::milli> milliseconds{5};
+    duration >> milliseconds;
+    EXPECT_EQ(DecodeError::invalidData, duration.getDecodeError());
+    EXPECT_EQ(5, milliseconds.count());
+
+    Serial code;
+    code << serialization::DictionaryCode{2 * 7 + 1};
+    ASSERT_EQ(DecodeError::none, code.validate());
+    serialization::DictionaryCode unknown;
+    code >> unknown;
+    ASSERT_EQ(DecodeError::none, code.getDecodeError());
+    std::string value{"unchanged"};
+    EXPECT_EQ(DecodeError::invalidData, dictionary.decode(unknown, value));
+    EXPECT_EQ("unchanged", value);
+    EXPECT_EQ(DecodeError::none, dictionary.decode(
+            dictionary.encode("known"), value));
+    EXPECT_EQ("known", value);
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//
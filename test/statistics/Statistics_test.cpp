@@ -0,0 +1,197 @@
+// Built into its own binary with SERIALIZATION_ENABLE_STATISTICS defined,
+// see Tupfile.
+
+#include <serialization/Payload.hpp>
+#include <serialization/Serial.hpp>
+#include <serialization/Statistics.hpp>
+#include <serialization/TypeList.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <thread>
+#include <utility>
+
+//============================================================================//
+namespace {
+//----------------------------------------------------------------------------//
+
+static_assert(serialization::STATISTICS_ENABLED,
+        "Statistics shall be enabled for this test!");
+
+struct Point {
+    std::int32_t x = 0;
+    std::int32_t y = 0;
+
+    template <typename Serial>
+    void serialize(Serial& serial) const {
+        serial << x << y;
+    }
+
+    template <typename Serial>
+    void deserialize(Serial& serial) {
+        serial >> x >> y;
+    }
+};
+
+using Serial = serialization::Serial<serialization::TypeList<Point>>;
+
+constexpr std::size_t INT32_ID = 2;
+constexpr std::size_t STRING_ID = 5;
+constexpr std::size_t POINT_ID = serialization::detail::getCustomTypeId(0);
+
+// The counters of the test since the fixture was set up.
+class StatisticsTest : public ::testing::Test {
+protected:
+    serialization::Statistics getDifference() const {
+        serialization::Statistics current = serialization::getStatistics();
+        for (std::size_t i = 0; i < current.encodedBytes.size(); ++i) {
+            current.encodedBytes[i] -= start.encodedBytes[i];
+            current.decodedBytes[i] -= start.decodedBytes[i];
+        }
+        for (std::size_t i = 0; i < current.keySizes.size(); ++i) {
+            current.keySizes[i] -= start.keySizes[i];
+            current.stringScanLengths[i] -= start.stringScanLengths[i];
+        }
+        current.growthCount -= start.growthCount;
+        current.grownBytes -= start.grownBytes;
+        return current;
+    }
+
+    const serialization::Statistics start = serialization::getStatistics();
+};
+
+//----------------------------------------------------------------------------//
+
+TEST(SizeClassTest, PowersOfTwo) {
+    EXPECT_EQ(0u, serialization::detail::getSizeClass(0));
+    EXPECT_EQ(1u, serialization::detail::getSizeClass(1));
+    EXPECT_EQ(2u, serialization::detail::getSizeClass(3));
+    EXPECT_EQ(3u, serialization::detail::getSizeClass(4));
+    EXPECT_EQ(64u, serialization::detail::getSizeClass(~std::uint64_t{0}));
+}
+
+TEST_F(StatisticsTest, BytesPerTypeId) {
+    Serial serial;
+    serial << Point{1, 2} << std::string{"abc"};
+    std::string text;
+    Point point;
+    serial >> point >> text;
+
+    const serialization::Statistics difference = getDifference();
+    EXPECT_EQ(2u * 5, difference.encodedBytes[INT32_ID]);
+    EXPECT_EQ(1u + 2 * 5, difference.encodedBytes[POINT_ID]);
+    EXPECT_EQ(1u + 4, difference.encodedBytes[STRING_ID]);
+    EXPECT_EQ(difference.encodedBytes, difference.decodedBytes);
+    EXPECT_EQ(1u, difference.stringScanLengths[3]);
+}
+
+TEST_F(StatisticsTest, FixedWidthRuns) {
+    Serial serial;
+    serial.packFixedWidths(std::int32_t{1}, std::int32_t{2});
+    std::int32_t x = 0;
+    std::int32_t y = 0;
+    serial.unpackFixedWidths(x, y);
+
+    const serialization::Statistics difference = getDifference();
+    EXPECT_EQ(2u * 5, difference.encodedBytes[INT32_ID]);
+    EXPECT_EQ(2u * 5, difference.decodedBytes[INT32_ID]);
+}
+
+TEST_F(StatisticsTest, KeySizes) {
+    {
+        Serial serial;
+        serial << std::int32_t{1} << std::int32_t{2};
+        serial.reset();
+        serial << std::int32_t{3};
+        Serial empty;
+    }
+    serialization::Payload<> payload;
+    payload << std::int32_t{1};
+    payload.reset();
+
+    const serialization::Statistics difference = getDifference();
+    EXPECT_EQ(1u, difference.keySizes[4]); // 10 bytes
+    EXPECT_EQ(1u, difference.keySizes[3]); // 5 bytes
+    EXPECT_EQ(0u, difference.keySizes[0]);
+    EXPECT_EQ(0u, difference.keySizes[2]); // the payload
+}
+
+TEST_F(StatisticsTest, DecodingIsNotCounted) {
+    std::string bytes;
+    {
+        Serial serial;
+        serial << std::int32_t{1};
+        bytes.assign(reinterpret_cast<const char*>(serial.data()),
+                serial.size());
+    }
+    const serialization::Statistics encoded = getDifference();
+    EXPECT_EQ(1u, encoded.keySizes[3]);
+
+    {
+        Serial serial{bytes.data(), bytes.size()};
+        std::int32_t value = 0;
+        serial >> value;
+        serial.reset();
+        Serial adopting;
+        adopting.adopt(serial.release());
+    }
+    EXPECT_EQ(encoded.keySizes, getDifference().keySizes);
+}
+
+TEST_F(StatisticsTest, MovedKeysAreCountedOnce) {
+    {
+        Serial first;
+        first << std::int32_t{1};
+        Serial second{std::move(first)};
+        Serial third;
+        third << std::int32_t{1} << std::int32_t{2};
+        third = std::move(second); // drops the 10 bytes
+    }
+    const serialization::Statistics difference = getDifference();
+    EXPECT_EQ(1u, difference.keySizes[4]);
+    EXPECT_EQ(1u, difference.keySizes[3]);
+    EXPECT_EQ(0u, difference.keySizes[0]);
+}
+
+TEST_F(StatisticsTest, BufferGrowth) {
+    Serial serial;
+    for (std::int32_t i = 0; i < 100; ++i) {
+        serial << i;
+    }
+    const std::size_t capacity = serial.capacity();
+    serial.reset();
+    for (std::int32_t i = 0; i < 100; ++i) {
+        serial << i;
+    }
+
+    const serialization::Statistics difference = getDifference();
+    EXPECT_LT(0u, difference.growthCount);
+    EXPECT_EQ(capacity, difference.grownBytes);
+}
+
+TEST_F(StatisticsTest, MergesThreads) {
+    std::promise<void> encoded;
+    std::promise<void> checked;
+    std::thread thread{[&] {
+        Serial serial;
+        serial << std::int32_t{1};
+        encoded.set_value();
+        checked.get_future().wait();
+        serial << std::int32_t{2};
+    }};
+
+    encoded.get_future().wait();
+    EXPECT_EQ(5u, getDifference().encodedBytes[INT32_ID]);
+    checked.set_value();
+    thread.join();
+    // The counters of a finished thread are kept.
+    EXPECT_EQ(10u, getDifference().encodedBytes[INT32_ID]);
+}
+
+//----------------------------------------------------------------------------//
+} // unnamed namespace
+//============================================================================//